@@ -0,0 +1,257 @@
+/* ================================== *\
+ @file     buffer_pool.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_BUFFER_POOL_HPP
+#define BANKER_BUFFER_POOL_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "banker/shared/compat.hpp"
+
+namespace banker
+{
+    /// @brief size classed cache of heap blocks, one per thread (see local()).
+    /// @details sizes are rounded up to a power of two between min_block and max_block,
+    /// freed blocks are kept in a per class free list and handed out again without touching the heap.
+    /// bigger requests go straight to the heap (counted as oversized).
+    /// blocks are plain operator new memory, so a block may be freed on another thread than
+    /// it was taken on, it then just ends up in that thread's cache.
+    class buffer_pool
+    {
+    public:
+        static constexpr size_t min_block = 64;
+        static constexpr size_t max_block = 1024 * 64;
+
+        /// @brief most bytes kept cached per size class, anything above goes back to the heap.
+        static constexpr size_t max_cached_bytes_per_class = 1024 * 1024;
+
+        struct stats
+        {
+            /// @brief allocate() calls.
+            uint64_t allocations{0};
+
+            /// @brief allocations served from the cache.
+            uint64_t hits{0};
+
+            /// @brief allocations that had to go to the heap (oversized included).
+            uint64_t misses{0};
+
+            /// @brief allocations above max_block.
+            uint64_t oversized{0};
+
+            /// @brief bytes handed out and not returned yet (rounded to block size).
+            size_t bytes_in_use{0};
+
+            /// @brief highest bytes_in_use seen.
+            size_t high_water_bytes{0};
+
+            /// @brief bytes sitting in the free lists.
+            size_t bytes_cached{0};
+
+            BANKER_NODISCARD double hit_rate() const
+            {
+                return allocations == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(allocations);
+            }
+        };
+
+    public:
+        buffer_pool()   = default;
+        ~buffer_pool()  { trim(); }
+
+        buffer_pool(const buffer_pool&)             = delete;
+        buffer_pool& operator=(const buffer_pool&)  = delete;
+
+        buffer_pool(buffer_pool&&)                  = delete;
+        buffer_pool& operator=(buffer_pool&&)       = delete;
+
+        /// @brief the pool of the calling thread.
+        static buffer_pool& local()
+        {
+            thread_local buffer_pool pool{};
+            return pool;
+        }
+
+        /// @brief the size a request of 'bytes' actually takes.
+        static constexpr size_t block_size(const size_t bytes)
+        {
+            if (bytes > max_block) return bytes;
+            size_t size = min_block;
+            while (size < bytes) size <<= 1;
+            return size;
+        }
+
+        /// @brief takes a block of at least 'bytes'.
+        BANKER_NODISCARD void* allocate(const size_t bytes)
+        {
+            const size_t size = block_size(bytes);
+            ++_stats.allocations;
+            _stats.bytes_in_use += size;
+            _stats.high_water_bytes = std::max(_stats.high_water_bytes, _stats.bytes_in_use);
+
+            if (size > max_block)
+            {
+                ++_stats.misses;
+                ++_stats.oversized;
+                return ::operator new(size);
+            }
+
+            free_list& list = _classes[_class_of(size)];
+            if (list.head != nullptr)
+            {
+                free_block* block = list.head;
+                list.head = block->next;
+                --list.count;
+                _stats.bytes_cached -= size;
+                ++_stats.hits;
+                return block;
+            }
+
+            ++_stats.misses;
+            return ::operator new(size);
+        }
+
+        /// @brief gives a block back.
+        /// @param ptr a block from allocate() (of any thread's pool).
+        /// @param bytes the size that was passed to allocate().
+        void deallocate(void* ptr, const size_t bytes) noexcept
+        {
+            if (ptr == nullptr) return;
+
+            const size_t size = block_size(bytes);
+            _stats.bytes_in_use -= std::min(size, _stats.bytes_in_use);
+
+            if (size > max_block)
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            free_list& list = _classes[_class_of(size)];
+            if ((list.count + 1) * size > max_cached_bytes_per_class)
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            auto* block = static_cast<free_block*>(ptr);
+            block->next = list.head;
+            list.head = block;
+            ++list.count;
+            _stats.bytes_cached += size;
+        }
+
+        /// @brief fills the cache so the next 'count' allocations of 'bytes' are hits.
+        void reserve(const size_t bytes, const size_t count)
+        {
+            const size_t size = block_size(bytes);
+            if (size > max_block) return;
+
+            std::vector<void*> blocks;
+            blocks.reserve(count);
+            for (size_t i = 0; i < count; ++i) blocks.push_back(::operator new(size));
+            for (void* block : blocks)
+            {
+                _stats.bytes_in_use += size;
+                deallocate(block, size);
+            }
+        }
+
+        /// @brief returns every cached block to the heap.
+        void trim() noexcept
+        {
+            for (free_list& list : _classes)
+            {
+                while (list.head != nullptr)
+                {
+                    free_block* block = list.head;
+                    list.head = block->next;
+                    ::operator delete(block);
+                }
+                list.count = 0;
+            }
+            _stats.bytes_cached = 0;
+        }
+
+        BANKER_NODISCARD const stats& get_stats() const { return _stats; }
+
+        /// @brief zeroes the counters, keeps bytes_in_use and bytes_cached.
+        void reset_stats()
+        {
+            _stats.allocations = 0;
+            _stats.hits = 0;
+            _stats.misses = 0;
+            _stats.oversized = 0;
+            _stats.high_water_bytes = _stats.bytes_in_use;
+        }
+
+    private:
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        struct free_list
+        {
+            free_block* head{nullptr};
+            size_t count{0};
+        };
+
+        static constexpr size_t _class_count = std::bit_width(max_block) - std::bit_width(min_block) + 1;
+
+        /// @param size a block_size() of at most max_block (a power of two).
+        static constexpr size_t _class_of(const size_t size)
+        {
+            return static_cast<size_t>(std::bit_width(size) - std::bit_width(min_block));
+        }
+
+        free_list _classes[_class_count]{};
+        stats _stats{};
+    };
+
+    /// @brief std allocator that draws from buffer_pool::local().
+    /// @details stateless, every instance is equal, so containers using it can be moved and swapped freely.
+    template<typename T>
+    class pool_allocator
+    {
+    public:
+        using value_type = T;
+
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                      "pool_allocator only provides the default new alignment");
+
+        pool_allocator() noexcept = default;
+
+        template<typename U>
+        pool_allocator(const pool_allocator<U>&) noexcept {}
+
+        BANKER_NODISCARD T* allocate(const size_t n)
+        {
+            return static_cast<T*>(buffer_pool::local().allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, const size_t n) noexcept
+        {
+            buffer_pool::local().deallocate(ptr, n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(const pool_allocator<U>&) const noexcept { return true; }
+
+        template<typename U>
+        bool operator!=(const pool_allocator<U>&) const noexcept { return false; }
+    };
+
+    /// @brief bytes backed by the calling thread's buffer_pool.
+    using pooled_bytes = std::vector<uint8_t, pool_allocator<uint8_t>>;
+}
+
+#endif //BANKER_BUFFER_POOL_HPP
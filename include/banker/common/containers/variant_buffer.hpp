@@ -9,23 +9,132 @@
 #define BANKER_VARIANT_BUFFER_HPP
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <new>
+#include <utility>
 #include <vector>
 
+#include "banker/common/containers/buffer_pool.hpp"
+#include "banker/shared/compat.hpp"
+
 namespace banker
 {
+    /// @brief immutable bytes that can be owned by many buffers at once.
+    using shared_bytes = std::shared_ptr<const std::vector<uint8_t>>;
+
+    /// @brief wraps bytes so they can be shared, the vector is moved, not copied.
+    inline shared_bytes make_shared_bytes(std::vector<uint8_t>&& data)
+    {
+        return std::make_shared<const std::vector<uint8_t>>(std::move(data));
+    }
+
+    /// @brief read only bytes that are either owned (vector / pooled_bytes / inline) or shared (shared_bytes).
+    /// @details shared buffers let one payload be queued in many places without copying it,
+    /// the payload is freed when the last variant_buffer referencing it is gone.
+    /// the data pointer stays the same when a variant_buffer is moved, except for inline bytes
+    /// (a few bytes kept inside the object itself, for headers).
     class variant_buffer
     {
     private:
         enum class variant : uint8_t
         {
             vector,
-            shared
+            pooled,
+            shared,
+            small
         };
 
     public:
-        variant_buffer() = default;
-        ~variant_buffer()
+        /// @brief most bytes that can be kept inline (a length header + a mac), fits in the
+        /// space the vectors take anyway.
+        static constexpr size_t inline_capacity = 20;
+
+        variant_buffer() : _buffer() {}
+        ~variant_buffer() { _destroy(); }
+
+        variant_buffer(const variant_buffer&) = delete;
+        variant_buffer& operator=(const variant_buffer&) = delete;
+
+        variant_buffer(variant_buffer&& other) noexcept
+        {
+            _take(std::move(other));
+        }
+
+        variant_buffer& operator=(variant_buffer&& other) noexcept
+        {
+            if (this == &other) return *this;
+            _destroy();
+            _take(std::move(other));
+            return *this;
+        }
+
+        explicit variant_buffer(std::vector<uint8_t>&& buffer) noexcept
+            : _buffer(std::move(buffer)) {}
+
+        explicit variant_buffer(pooled_bytes&& buffer) noexcept
+            : _variant(variant::pooled), _pooled_buffer(std::move(buffer)) {}
+
+        explicit variant_buffer(shared_bytes buffer) noexcept
+            : _variant(variant::shared), _shared_buffer(std::move(buffer)) {}
+
+        /// @brief copies the bytes into the object itself (no allocation) when they fit in inline_capacity,
+        /// into an owned vector otherwise. never truncates.
+        static variant_buffer make_inline(const void* data, const size_t size)
+        {
+            if (size > inline_capacity)
+            {
+                const auto* bytes = static_cast<const uint8_t*>(data);
+                return variant_buffer{std::vector<uint8_t>(bytes, bytes + size)};
+            }
+
+            variant_buffer buffer{};
+            buffer._destroy();
+            buffer._variant = variant::small;
+            new (&buffer._inline_buffer) inline_bytes{};
+            buffer._inline_buffer.size = static_cast<uint8_t>(size);
+            std::memcpy(buffer._inline_buffer.bytes, data, size);
+            return buffer;
+        }
+
+        /// @brief if the bytes are shared with other buffers.
+        BANKER_NODISCARD bool is_shared() const { return _variant == variant::shared; }
+
+        BANKER_NODISCARD const uint8_t* data() const
+        {
+            if (_variant == variant::vector) return _buffer.data();
+            if (_variant == variant::pooled) return _pooled_buffer.data();
+            if (_variant == variant::small) return _inline_buffer.bytes;
+            return _shared_buffer ? _shared_buffer->data() : nullptr;
+        }
+
+        BANKER_NODISCARD size_t size() const
+        {
+            if (_variant == variant::vector) return _buffer.size();
+            if (_variant == variant::pooled) return _pooled_buffer.size();
+            if (_variant == variant::small) return _inline_buffer.size;
+            return _shared_buffer ? _shared_buffer->size() : 0;
+        }
+
+        BANKER_NODISCARD bool empty() const { return size() == 0; }
+
+    private:
+        struct inline_bytes
+        {
+            uint8_t bytes[inline_capacity];
+            uint8_t size;
+        };
+
+        variant _variant{variant::vector};
+        union
+        {
+            inline_bytes            _inline_buffer;
+            std::vector<uint8_t>    _buffer;
+            pooled_bytes            _pooled_buffer;
+            shared_bytes            _shared_buffer;
+        };
+
+        void _destroy() noexcept
         {
             switch (_variant)
             {
@@ -33,25 +142,42 @@ namespace banker
                     _buffer.~vector();
                     break;
 
+                case variant::pooled:
+                    _pooled_buffer.~pooled_bytes();
+                    break;
+
                 case variant::shared:
                     _shared_buffer.~shared_ptr();
                     break;
+
+                case variant::small:
+                    break;
             }
         }
 
-        variant_buffer(const variant_buffer&) = delete;
-        variant_buffer& operator=(const variant_buffer&) = delete;
+        /// @brief constructs from 'other', this must not hold a live member.
+        void _take(variant_buffer&& other) noexcept
+        {
+            _variant = other._variant;
+            switch (_variant)
+            {
+                case variant::vector:
+                    new (&_buffer) std::vector<uint8_t>(std::move(other._buffer));
+                    break;
 
-        variant_buffer(variant_buffer&&) noexcept = default;
-        variant_buffer& operator=(variant_buffer&&) noexcept = default;
+                case variant::pooled:
+                    new (&_pooled_buffer) pooled_bytes(std::move(other._pooled_buffer));
+                    break;
 
-    private:
-        variant _variant{variant::vector};
-        union
-        {
-            std::vector<uint8_t>                    _buffer{};
-            std::shared_ptr<std::vector<uint8_t>>   _shared_buffer;
-        };
+                case variant::shared:
+                    new (&_shared_buffer) shared_bytes(std::move(other._shared_buffer));
+                    break;
+
+                case variant::small:
+                    new (&_inline_buffer) inline_bytes(other._inline_buffer);
+                    break;
+            }
+        }
     };
 }
 
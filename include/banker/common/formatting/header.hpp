@@ -11,6 +11,7 @@
 #include <iomanip>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 namespace banker::common::formatting
 {
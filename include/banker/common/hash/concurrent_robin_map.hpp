@@ -0,0 +1,419 @@
+/* ================================== *\
+ @file     concurrent_robin_map.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_CONCURRENT_ROBIN_MAP_HPP
+#define BANKER_CONCURRENT_ROBIN_MAP_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+#endif
+
+#include "banker/common/hash/robin_hash.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::common
+{
+    /// @brief robin hood hash map for many reader and a few writer threads.
+    /// @details the keys are spread over 'Shards' cache line aligned shards (by the high hash bits),
+    /// each an open addressing robin hood table like robin_map. writers take the shard's spinlock and
+    /// bump its sequence counter around every change; find() never locks, it reads optimistically and
+    /// retries if the sequence moved (a seqlock). tables that were grown away from are kept until
+    /// reclaim() (or destruction), so a reader that is still probing an old table never touches freed memory.
+    /// @tparam K, V trivially copyable (ids, handles, indices, small structs), readers copy them out
+    /// while a writer may be changing them.
+    template<typename K, typename V, typename Hash = robin_hash<K>, size_t Shards = 64>
+    class concurrent_robin_map
+    {
+        static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>,
+                      "concurrent_robin_map needs trivially copyable keys and values");
+        static_assert(Shards > 0 && (Shards & (Shards - 1)) == 0, "Shards must be a power of two");
+
+    public:
+        static constexpr float load_factor = 0.7f;
+
+    public:
+        concurrent_robin_map() = default;
+
+        ~concurrent_robin_map()
+        {
+            for (shard& s : _shards)
+            {
+                _free_table(s.current.load(std::memory_order_relaxed));
+                for (table* t : s.retired) _free_table(t);
+            }
+        }
+
+        concurrent_robin_map(const concurrent_robin_map&)             = delete;
+        concurrent_robin_map& operator=(const concurrent_robin_map&)  = delete;
+
+        concurrent_robin_map(concurrent_robin_map&&)                  = delete;
+        concurrent_robin_map& operator=(concurrent_robin_map&&)       = delete;
+
+        /// @brief inserts or overwrites.
+        /// @return true -> the key is new.
+        bool insert(const K& key, const V& value)
+        {
+            const uint64_t h = _hasher(key);
+            shard& s = _shard_of(h);
+            write_guard guard{s};
+
+            table* t = s.current.load(std::memory_order_relaxed);
+            if (t != nullptr)
+            {
+                const size_t pos = _find_slot(*t, key, h);
+                if (pos != _npos)
+                {
+                    std::memcpy(&t->values[pos], &value, sizeof(V));
+                    return false;
+                }
+            }
+
+            if (t == nullptr || s.count + 1 > _max_load(*t))
+                t = _grow(s, t == nullptr ? _min_capacity : t->capacity * 2);
+
+            while (!_place(*t, key, value, h)) t = _grow(s, t->capacity * 2);
+            ++s.count;
+            return true;
+        }
+
+        /// @return true -> the key was there.
+        bool erase(const K& key)
+        {
+            const uint64_t h = _hasher(key);
+            shard& s = _shard_of(h);
+            write_guard guard{s};
+
+            table* t = s.current.load(std::memory_order_relaxed);
+            if (t == nullptr) return false;
+
+            size_t pos = _find_slot(*t, key, h);
+            if (pos == _npos) return false;
+
+            const size_t mask = t->capacity - 1;
+            size_t next = (pos + 1) & mask;
+            while (t->dist[next] > 1)
+            {
+                std::memcpy(&t->keys[pos], &t->keys[next], sizeof(K));
+                std::memcpy(&t->values[pos], &t->values[next], sizeof(V));
+                t->dist[pos] = static_cast<uint8_t>(t->dist[next] - 1);
+                pos = next;
+                next = (next + 1) & mask;
+            }
+            t->dist[pos] = 0;
+            --s.count;
+            return true;
+        }
+
+        /// @brief lock free lookup.
+        /// @return a copy of the value, or nothing.
+        std::optional<V> find(const K& key) const
+        {
+            const uint64_t h = _hasher(key);
+            const shard& s = _shard_of(h);
+
+            while (true)
+            {
+                const uint32_t before = s.seq.load(std::memory_order_acquire);
+                if (before & 1)
+                {
+                    _relax();
+                    continue;
+                }
+
+                bool found = false;
+                V value;
+                const table* t = s.current.load(std::memory_order_acquire);
+                if (t != nullptr)
+                {
+                    const size_t pos = _find_slot(*t, key, h);
+                    if (pos != _npos)
+                    {
+                        std::memcpy(&value, &t->values[pos], sizeof(V));
+                        found = true;
+                    }
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) != before) continue;
+
+                if (!found) return std::nullopt;
+                return value;
+            }
+        }
+
+        bool contains(const K& key) const { return find(key).has_value(); }
+
+        /// @brief entries right now (a snapshot, other threads may be changing it).
+        size_t size() const
+        {
+            size_t total = 0;
+            for (const shard& s : _shards) total += s.count_snapshot.load(std::memory_order_relaxed);
+            return total;
+        }
+
+        /// @brief makes room for 'count' entries (spread evenly) without growing.
+        void reserve(const size_t count)
+        {
+            const size_t per_shard = count / Shards + 1;
+            size_t capacity = _min_capacity;
+            while (static_cast<float>(capacity) * load_factor < static_cast<float>(per_shard)) capacity <<= 1;
+
+            for (shard& s : _shards)
+            {
+                write_guard guard{s};
+                table* t = s.current.load(std::memory_order_relaxed);
+                if (t == nullptr || t->capacity < capacity) _grow(s, capacity);
+            }
+        }
+
+        /// @brief calls f(key, value) for every entry.
+        /// @details each shard is copied out under its lock and f runs on the copy with no lock held,
+        /// so f may insert, erase or find (the changes may or may not show up later in the walk).
+        template<typename F>
+        void for_each(F&& f) const
+        {
+            std::vector<std::pair<K, V>> entries{};
+            for (const shard& s : _shards)
+            {
+                entries.clear();
+                {
+                    write_guard guard{const_cast<shard&>(s)};
+                    const table* t = s.current.load(std::memory_order_relaxed);
+                    if (t == nullptr) continue;
+
+                    for (size_t i = 0; i < t->capacity; ++i)
+                        if (t->dist[i] != 0) entries.emplace_back(t->keys[i], t->values[i]);
+                }
+
+                for (const auto& [key, value] : entries) f(key, value);
+            }
+        }
+
+        void clear()
+        {
+            for (shard& s : _shards)
+            {
+                write_guard guard{s};
+                table* t = s.current.load(std::memory_order_relaxed);
+                if (t != nullptr) std::memset(t->dist, 0, t->capacity);
+                s.count = 0;
+            }
+        }
+
+        /// @brief frees the tables shards have grown away from.
+        /// @warning only call when no thread can be inside find().
+        void reclaim()
+        {
+            for (shard& s : _shards)
+            {
+                write_guard guard{s};
+                for (table* t : s.retired) _free_table(t);
+                s.retired.clear();
+            }
+        }
+
+    private:
+        struct table
+        {
+            size_t capacity{0};
+
+            /// @brief probe distance + 1 per slot, 0 -> empty.
+            uint8_t* dist{nullptr};
+            K* keys{nullptr};
+            V* values{nullptr};
+        };
+
+        struct alignas(64) shard
+        {
+            std::atomic<uint32_t> seq{0};
+            std::atomic<bool> locked{false};
+            std::atomic<table*> current{nullptr};
+            std::atomic<size_t> count_snapshot{0};
+            size_t count{0};
+            std::vector<table*> retired{};
+        };
+
+        /// @brief spinlock + seqlock bump for the duration of a change.
+        struct write_guard
+        {
+            shard& s;
+
+            explicit write_guard(shard& sh) : s(sh)
+            {
+                while (true)
+                {
+                    if (!s.locked.exchange(true, std::memory_order_acquire)) break;
+                    while (s.locked.load(std::memory_order_relaxed)) _relax();
+                }
+                s.seq.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            ~write_guard()
+            {
+                s.count_snapshot.store(s.count, std::memory_order_relaxed);
+                s.seq.fetch_add(1, std::memory_order_release);
+                s.locked.store(false, std::memory_order_release);
+            }
+
+            write_guard(const write_guard&)             = delete;
+            write_guard& operator=(const write_guard&)  = delete;
+        };
+
+        static constexpr size_t _npos = ~size_t{0};
+        static constexpr size_t _min_capacity = 16;
+        static constexpr uint8_t _max_dist = 255;
+        static constexpr unsigned _shard_shift = 64 - std::bit_width(Shards - 1);
+
+        shard _shards[Shards]{};
+        [[no_unique_address]] Hash _hasher{};
+
+        static void _relax()
+        {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            _mm_pause();
+#else
+            std::this_thread::yield();
+#endif
+        }
+
+        shard& _shard_of(const uint64_t h)
+        {
+            if constexpr (Shards == 1) return _shards[0];
+            else return _shards[h >> _shard_shift];
+        }
+
+        const shard& _shard_of(const uint64_t h) const
+        {
+            if constexpr (Shards == 1) return _shards[0];
+            else return _shards[h >> _shard_shift];
+        }
+
+        static size_t _max_load(const table& t)
+        {
+            return static_cast<size_t>(static_cast<float>(t.capacity) * load_factor);
+        }
+
+        /// @brief bounded probe, also safe on a table a writer is changing (the result is then thrown away).
+        static size_t _find_slot(const table& t, const K& key, const uint64_t h)
+        {
+            const size_t mask = t.capacity - 1;
+            size_t pos = static_cast<size_t>(h) & mask;
+            for (size_t dist = 1; dist < _max_dist && t.dist[pos] >= dist; ++dist)
+            {
+                if (t.dist[pos] == dist)
+                {
+                    K k;
+                    std::memcpy(&k, &t.keys[pos], sizeof(K));
+                    if (k == key) return pos;
+                }
+                pos = (pos + 1) & mask;
+            }
+            return _npos;
+        }
+
+        /// @brief robin hood insert of a key that isn't in the table.
+        /// @return false -> a probe got too long, grow and retry.
+        static bool _place(table& t, K key, V value, const uint64_t h)
+        {
+            const size_t mask = t.capacity - 1;
+            {
+                size_t pos = static_cast<size_t>(h) & mask;
+                uint8_t dist = 1;
+                while (t.dist[pos] != 0)
+                {
+                    if (t.dist[pos] < dist) dist = t.dist[pos];
+                    if (dist == _max_dist - 1) return false;
+                    pos = (pos + 1) & mask;
+                    ++dist;
+                }
+            }
+
+            size_t pos = static_cast<size_t>(h) & mask;
+            uint8_t dist = 1;
+            while (true)
+            {
+                if (t.dist[pos] == 0)
+                {
+                    std::memcpy(&t.keys[pos], &key, sizeof(K));
+                    std::memcpy(&t.values[pos], &value, sizeof(V));
+                    t.dist[pos] = dist;
+                    return true;
+                }
+
+                if (t.dist[pos] < dist)
+                {
+                    std::swap(key, t.keys[pos]);
+                    std::swap(value, t.values[pos]);
+                    std::swap(dist, t.dist[pos]);
+                }
+
+                pos = (pos + 1) & mask;
+                ++dist;
+            }
+        }
+
+        /// @brief moves the shard to a new table of 'capacity' slots, the old one is retired.
+        /// @note call with the shard locked.
+        table* _grow(shard& s, const size_t capacity)
+        {
+            table* old = s.current.load(std::memory_order_relaxed);
+            table* next = _new_table(capacity);
+
+            if (old != nullptr)
+            {
+                for (size_t i = 0; i < old->capacity; ++i)
+                {
+                    if (old->dist[i] == 0) continue;
+                    const uint64_t h = _hasher(old->keys[i]);
+                    if (!_place(*next, old->keys[i], old->values[i], h))
+                    {
+                        _free_table(next);
+                        return _grow(s, capacity * 2);
+                    }
+                }
+                s.retired.push_back(old);
+            }
+
+            s.current.store(next, std::memory_order_release);
+            return next;
+        }
+
+        static table* _new_table(const size_t capacity)
+        {
+            auto* t = new table{};
+            t->capacity = capacity;
+            t->dist = new uint8_t[capacity]{};
+            t->keys = std::allocator<K>{}.allocate(capacity);
+            t->values = std::allocator<V>{}.allocate(capacity);
+            return t;
+        }
+
+        static void _free_table(table* t)
+        {
+            if (t == nullptr) return;
+            delete[] t->dist;
+            std::allocator<K>{}.deallocate(t->keys, t->capacity);
+            std::allocator<V>{}.deallocate(t->values, t->capacity);
+            delete t;
+        }
+    };
+}
+
+#endif //BANKER_CONCURRENT_ROBIN_MAP_HPP
@@ -8,160 +8,361 @@
 #ifndef BANKER_ROBIN_HASH_HPP
 #define BANKER_ROBIN_HASH_HPP
 
-#include <cassert>
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <type_traits>
-#include <vector>
+#include <utility>
 
 namespace banker::common
 {
-    template<typename K, typename V, float load_factor = 0.7f>
+    /// @brief murmur3's 64 bit finalizer, every input bit affects every output bit.
+    constexpr uint64_t mix64(uint64_t x)
+    {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    /// @brief default robin_map hasher: integers are mixed directly, anything else goes through
+    /// std::hash first (which is the identity for integers on most standard libraries) and is mixed after.
+    template<typename K>
+    struct robin_hash
+    {
+        uint64_t operator()(const K& key) const
+        {
+            if constexpr (std::is_integral_v<K> || std::is_enum_v<K>)
+                return mix64(static_cast<uint64_t>(key));
+            else
+                return mix64(static_cast<uint64_t>(std::hash<K>{}(key)));
+        }
+    };
+
+    /// @brief open addressing hash map with robin hood probing and backward shift deletion.
+    /// @details the probe distances live in their own byte array next to the keys, values are kept
+    /// apart, so a lookup scans a few bytes and keys and only touches the value it returns.
+    /// @tparam Hash returns a well mixed 64 bit hash (the low bits pick the slot), after load_factor
+    /// so robin_map<K, V, 0.8f> keeps meaning what it did.
+    template<typename K, typename V, float load_factor = 0.7f, typename Hash = robin_hash<K>>
     class robin_map
     {
-        static_assert(std::is_integral_v<K>, "robin_hash only supports integral keys");
-        static_assert(!std::is_signed_v<K>, "robin_hash only supports unsigned keys");
         static_assert(load_factor > 0 && load_factor < 1, "load_factor must be between 0 and 1");
 
-    private:
-        struct robin_node
+    public:
+        template<bool Const>
+        class basic_iterator
         {
-            K key = empty_key;
-            V value{};
-            uint8_t distance{};
+        public:
+            using map_type      = std::conditional_t<Const, const robin_map, robin_map>;
+            using value_ref     = std::conditional_t<Const, const V&, V&>;
+            using value_type    = std::pair<const K&, value_ref>;
+
+            basic_iterator() = default;
+            basic_iterator(map_type* map, const size_t index) : _map(map), _index(index) { _skip(); }
+
+            value_type operator*() const { return {_map->_keys[_index], _map->_values[_index]}; }
+
+            const K& key() const { return _map->_keys[_index]; }
+            value_ref value() const { return _map->_values[_index]; }
+
+            basic_iterator& operator++()
+            {
+                ++_index;
+                _skip();
+                return *this;
+            }
+
+            bool operator==(const basic_iterator& other) const { return _index == other._index; }
+            bool operator!=(const basic_iterator& other) const { return _index != other._index; }
+
+        private:
+            map_type* _map{nullptr};
+            size_t _index{0};
+
+            void _skip()
+            {
+                while (_index < _map->_capacity && _map->_dist[_index] == 0) ++_index;
+            }
         };
 
+        using iterator          = basic_iterator<false>;
+        using const_iterator    = basic_iterator<true>;
+
     public:
         robin_map() = default;
-        ~robin_map() = default;
-        robin_map(const robin_map&) = default;
-        robin_map(robin_map&&) = default;
-        robin_map& operator=(const robin_map&) = default;
-        robin_map& operator=(robin_map&&) = default;
+        ~robin_map() { _release(); }
 
-        explicit robin_map(const size_t initial_capacity = 128)
+        explicit robin_map(const size_t initial_capacity, const Hash& hash = Hash{})
+            : _hasher(hash)
         {
-            size_t cap = 1;
-            while (cap < initial_capacity) cap <<= 1;
-            table.resize(cap, robin_node{empty_key, V{}, 0});
-            mask = cap - 1;
-            count = 0;
+            _allocate(_capacity_for(initial_capacity));
         }
 
-        static constexpr K empty_key = static_cast<K>( ~0 );
+        robin_map(const robin_map& other)
+            : _hasher(other._hasher)
+        {
+            _allocate(other._capacity);
+            for (auto [key, value] : other) insert(key, value);
+        }
 
-        void insert(K key, V value)
+        robin_map& operator=(const robin_map& other)
         {
-            if ((count + 1) > table.size() * load_factor)
-                _resize(table.size() * 2);
+            if (this == &other) return *this;
+            robin_map copy{other};
+            swap(copy);
+            return *this;
+        }
 
-            size_t pos = key & mask;
-            uint8_t dist = 0;
+        robin_map(robin_map&& other) noexcept { swap(other); }
 
-            while (true)
+        robin_map& operator=(robin_map&& other) noexcept
+        {
+            if (this == &other) return *this;
+            _release();
+            swap(other);
+            return *this;
+        }
+
+        void swap(robin_map& other) noexcept
+        {
+            std::swap(_dist, other._dist);
+            std::swap(_keys, other._keys);
+            std::swap(_values, other._values);
+            std::swap(_capacity, other._capacity);
+            std::swap(_count, other._count);
+            std::swap(_hasher, other._hasher);
+        }
+
+        /// @brief inserts or overwrites.
+        /// @return true -> the key is new, false -> an existing value was replaced.
+        bool insert(K key, V value)
+        {
+            if (V* existing = find(key))
             {
-                if (table[pos].key == empty_key)
-                {
-                    table[pos] = {key, std::move(value), dist};
-                    ++count;
-                    return;
-                }
+                *existing = std::move(value);
+                return false;
+            }
 
-                if (table[pos].key == key)
-                {
-                    table[pos].value = std::move(value);
-                    return;
-                }
+            if (_count + 1 > _max_load()) _rehash(_capacity == 0 ? _min_capacity : _capacity * 2);
+            while (!_place(key, value)) _rehash(_capacity * 2);
+            ++_count;
+            return true;
+        }
 
-                if (table[pos].distance < dist)
-                {
-                    std::swap(key, table[pos].key);
-                    std::swap(value, table[pos].value);
-                    std::swap(dist, table[pos].distance);
-                }
+        V* find(const K& key)
+        {
+            const size_t pos = _find_slot(key);
+            return pos == _npos ? nullptr : &_values[pos];
+        }
 
-                pos = (pos + 1) & mask;
-                ++dist;
-                assert(dist < 255);
-            }
+        const V* find(const K& key) const
+        {
+            const size_t pos = _find_slot(key);
+            return pos == _npos ? nullptr : &_values[pos];
         }
 
-        V* find(K key)
+        bool contains(const K& key) const { return _find_slot(key) != _npos; }
+
+        /// @return true -> the key was there.
+        bool erase(const K& key)
         {
-            size_t pos = key & mask;
-            uint8_t dist = 0;
+            size_t pos = _find_slot(key);
+            if (pos == _npos) return false;
 
-            while (table[pos].key != empty_key)
+            // backward shift: pull the following displaced entries one slot closer to home.
+            size_t next = (pos + 1) & _mask();
+            while (_dist[next] > 1)
             {
-                if (table[pos].key == key) return &table[pos].value;
-                if (table[pos].distance < dist) return nullptr;
+                _keys[pos] = std::move(_keys[next]);
+                _values[pos] = std::move(_values[next]);
+                _dist[pos] = static_cast<uint8_t>(_dist[next] - 1);
+                pos = next;
+                next = (next + 1) & _mask();
+            }
 
-                pos = (pos + 1) & mask;
-                ++dist;
+            std::destroy_at(&_keys[pos]);
+            std::destroy_at(&_values[pos]);
+            _dist[pos] = 0;
+            --_count;
+            return true;
+        }
+
+        void clear()
+        {
+            for (size_t i = 0; i < _capacity; ++i)
+            {
+                if (_dist[i] == 0) continue;
+                std::destroy_at(&_keys[i]);
+                std::destroy_at(&_values[i]);
+                _dist[i] = 0;
+            }
+            _count = 0;
+        }
+
+        /// @brief makes room for 'count' entries without rehashing.
+        void reserve(const size_t count)
+        {
+            const size_t needed = _capacity_for(count);
+            if (needed > _capacity) _rehash(needed);
+        }
+
+        size_t size() const { return _count; }
+        bool empty() const { return _count == 0; }
+        size_t capacity() const { return _capacity; }
+
+        const Hash& hash_function() const { return _hasher; }
+
+        /// @brief longest probe a lookup of a present key takes (1 -> found in its home slot).
+        size_t max_probe_length() const
+        {
+            uint8_t longest = 0;
+            for (size_t i = 0; i < _capacity; ++i) longest = std::max(longest, _dist[i]);
+            return longest;
+        }
+
+        /// @brief average probe length over the present keys.
+        double mean_probe_length() const
+        {
+            if (_count == 0) return 0;
+            uint64_t total = 0;
+            for (size_t i = 0; i < _capacity; ++i) total += _dist[i];
+            return static_cast<double>(total) / static_cast<double>(_count);
+        }
+
+        iterator begin() { return iterator{this, 0}; }
+        iterator end() { return iterator{this, _capacity}; }
+        const_iterator begin() const { return const_iterator{this, 0}; }
+        const_iterator end() const { return const_iterator{this, _capacity}; }
+
+    private:
+        static constexpr size_t _npos = ~size_t{0};
+        static constexpr size_t _min_capacity = 16;
+
+        /// @brief probe distances are stored + 1 (0 = empty), so at most 254 steps; past that the table grows.
+        static constexpr uint8_t _max_dist = 255;
+
+        /// @brief probe distance + 1 per slot, 0 -> empty.
+        std::unique_ptr<uint8_t[]> _dist{};
+        K* _keys{nullptr};
+        V* _values{nullptr};
+        size_t _capacity{0};
+        size_t _count{0};
+        [[no_unique_address]] Hash _hasher{};
+
+        size_t _mask() const { return _capacity - 1; }
+        size_t _max_load() const { return static_cast<size_t>(static_cast<float>(_capacity) * load_factor); }
+
+        static size_t _capacity_for(const size_t count)
+        {
+            size_t cap = _min_capacity;
+            while (static_cast<float>(cap) * load_factor < static_cast<float>(count)) cap <<= 1;
+            return cap;
+        }
+
+        size_t _home(const K& key) const { return static_cast<size_t>(_hasher(key)) & _mask(); }
+
+        size_t _find_slot(const K& key) const
+        {
+            if (_count == 0) return _npos;
+
+            size_t pos = _home(key);
+            for (uint8_t dist = 1; _dist[pos] >= dist; ++dist)
+            {
+                if (_dist[pos] == dist && _keys[pos] == key) return pos;
+                pos = (pos + 1) & _mask();
             }
-            return nullptr;
+            return _npos;
         }
 
-        void erase(K key)
+        /// @brief places a key that isn't in the map yet.
+        /// @return false -> a probe got too long, grow and try again (key and value are left intact).
+        bool _place(K& key, V& value)
         {
-            size_t pos = key & mask;
-            uint8_t dist = 0;
+            // dry run first, so a failing insert doesn't leave entries shuffled around.
+            {
+                size_t pos = _home(key);
+                uint8_t dist = 1;
+                while (_dist[pos] != 0)
+                {
+                    if (_dist[pos] < dist) dist = _dist[pos];
+                    if (dist == _max_dist - 1) return false;
+                    pos = (pos + 1) & _mask();
+                    ++dist;
+                }
+            }
 
-            while (table[pos].key != empty_key)
+            size_t pos = _home(key);
+            uint8_t dist = 1;
+            K k = std::move(key);
+            V v = std::move(value);
+            while (true)
             {
-                if (table[pos].key == key)
+                if (_dist[pos] == 0)
                 {
-                    size_t next = (pos + 1) & mask;
-                    while (table[next].key != empty_key && table[next].distance > 0)
-                    {
-                        table[pos] = table[next];
-                        --table[pos].distance;
-                        pos = next;
-                        next = (next + 1) & mask;
-                    }
-
-                    table[pos].key = empty_key;
-                    table[pos].distance = 0;
-                    --count;
-                    return;
+                    std::construct_at(&_keys[pos], std::move(k));
+                    std::construct_at(&_values[pos], std::move(v));
+                    _dist[pos] = dist;
+                    return true;
                 }
 
-                if (table[pos].distance < dist) return;
-                pos = (pos + 1) & mask;
+                // robin hood: the richer entry (closer to home) gives its slot up.
+                if (_dist[pos] < dist)
+                {
+                    std::swap(k, _keys[pos]);
+                    std::swap(v, _values[pos]);
+                    std::swap(dist, _dist[pos]);
+                }
+
+                pos = (pos + 1) & _mask();
                 ++dist;
             }
         }
 
-        void clear()
+        void _allocate(const size_t capacity)
         {
-            for (auto& e : table)
-            {
-                e.key = empty_key;
-                e.distance = 0;
-            }
-            count = 0;
-        }
+            _capacity = capacity;
+            _count = 0;
+            if (capacity == 0) return;
 
-        size_t size() const { return count; }
+            _dist = std::make_unique<uint8_t[]>(capacity);
+            _keys = std::allocator<K>{}.allocate(capacity);
+            _values = std::allocator<V>{}.allocate(capacity);
+        }
 
-    private:
-        std::vector<robin_node> table{};
-        size_t mask{};
-        size_t count{};
+        void _release()
+        {
+            clear();
+            if (_keys != nullptr) std::allocator<K>{}.deallocate(_keys, _capacity);
+            if (_values != nullptr) std::allocator<V>{}.deallocate(_values, _capacity);
+            _keys = nullptr;
+            _values = nullptr;
+            _dist.reset();
+            _capacity = 0;
+        }
 
-        void _resize(size_t new_size)
+        /// @brief moves every entry into a table of 'capacity' slots.
+        void _rehash(const size_t capacity)
         {
-            std::vector<robin_node> old_table = std::move(table);
-            table.clear();
-            table.resize(new_size, robin_node{empty_key, V{}, 0});
-            mask = new_size - 1;
-            count = 0;
+            robin_map next{};
+            next._hasher = _hasher;
+            next._allocate(capacity);
 
-            for (auto& e : old_table)
+            for (size_t i = 0; i < _capacity; ++i)
             {
-                if (e.key != empty_key) insert(e.key, e.value);
+                if (_dist[i] == 0) continue;
+                while (!next._place(_keys[i], _values[i])) next._rehash(next._capacity * 2);
+                ++next._count;
             }
+
+            _release();
+            swap(next);
         }
     };
 }
 
-#endif //BANKER_ROBIN_HASH_HPP
\ No newline at end of file
+#endif //BANKER_ROBIN_HASH_HPP
@@ -0,0 +1,417 @@
+/* ================================== *\
+ @file     timer_wheel.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_TIMER_WHEEL_HPP
+#define BANKER_TIMER_WHEEL_HPP
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "banker/shared/compat.hpp"
+
+namespace banker::time
+{
+    using timer_id = uint64_t;
+    static constexpr timer_id invalid_timer = ~0ULL;
+
+    /// @brief hierarchical timing wheel (4 levels of 256 slots), for timeouts and scheduled work on a poll loop.
+    /// @details schedule(), reschedule() and cancel() are O(1): timers sit in intrusive lists, one per slot.
+    /// level 0 holds what expires within 256 ticks, each level above covers 256x the range of the one
+    /// below and is cascaded down when the lower level wraps. ids are generational (like stable_storage),
+    /// so cancelling a timer that already fired is harmless.
+    /// @code{.cpp}
+    /// timer_wheel timers{std::chrono::milliseconds(10)};
+    /// const timer_id id = timers.schedule(std::chrono::seconds(30), connection_id);
+    /// ...
+    /// const int timeout = timers.poll_timeout(timer_wheel::clock::now(), 1000);
+    /// poller.poll(timeout);
+    /// timers.advance(timer_wheel::clock::now(), [&](timer_id, uint64_t user_data) { ... });
+    /// @endcode
+    class timer_wheel
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        static constexpr size_t level_bits  = 8;
+        static constexpr size_t slots       = size_t{1} << level_bits;
+        static constexpr size_t levels      = 4;
+
+    public:
+        /// @param resolution length of one tick, timers fire at most one tick late.
+        /// @param start the time tick 0 starts at.
+        explicit timer_wheel(
+            const clock::duration resolution = std::chrono::milliseconds(1),
+            const clock::time_point start = clock::now())
+            : _resolution(std::max(resolution, clock::duration(1))), _start(start)
+        {
+            _nodes.resize(_sentinel_count);
+            for (uint32_t i = 0; i < _sentinel_count; ++i)
+            {
+                _nodes[i].prev = i;
+                _nodes[i].next = i;
+            }
+        }
+
+        timer_wheel(const timer_wheel&)             = delete;
+        timer_wheel& operator=(const timer_wheel&)  = delete;
+
+        timer_wheel(timer_wheel&&) noexcept             = default;
+        timer_wheel& operator=(timer_wheel&&) noexcept  = default;
+
+        /// @brief fires 'user_data' after 'delay' (rounded up to whole ticks, at least one).
+        BANKER_NODISCARD timer_id schedule(
+            const clock::duration delay,
+            const uint64_t user_data,
+            const clock::time_point now = clock::now())
+        {
+            uint32_t index;
+            if (_free_head != _no_node)
+            {
+                index = _free_head;
+                _free_head = _nodes[index].next;
+            }
+            else
+            {
+                index = static_cast<uint32_t>(_nodes.size());
+                _nodes.push_back(node{});
+            }
+
+            node& n = _nodes[index];
+            ++n.generation;     // odd -> scheduled.
+            n.user_data = user_data;
+            n.expires = _expiry(delay, now);
+            _link(index);
+            ++_count;
+
+            return (static_cast<timer_id>(n.generation) << 32) | index;
+        }
+
+        /// @brief moves a scheduled timer to 'delay' from now, keeping its id.
+        /// @return false -> it already fired or was cancelled.
+        bool reschedule(
+            const timer_id id,
+            const clock::duration delay,
+            const clock::time_point now = clock::now())
+        {
+            const uint32_t index = _resolve(id);
+            if (index == _no_node) return false;
+
+            _unlink(index);
+            _nodes[index].expires = _expiry(delay, now);
+            _link(index);
+            return true;
+        }
+
+        /// @return false -> it already fired or was cancelled.
+        bool cancel(const timer_id id)
+        {
+            const uint32_t index = _resolve(id);
+            if (index == _no_node) return false;
+
+            _unlink(index);
+            _release(index);
+            return true;
+        }
+
+        BANKER_NODISCARD bool contains(const timer_id id) const { return _resolve(id) != _no_node; }
+
+        /// @brief fires every timer that expired by 'now', in expiry order (ties in any order).
+        /// @param on_expire called as on_expire(timer_id, uint64_t user_data), may schedule and cancel.
+        /// @return amount of timers fired.
+        template<typename F>
+        size_t advance(const clock::time_point now, F&& on_expire)
+        {
+            const uint64_t target = _tick_of(now);
+            size_t fired = 0;
+
+            while (_now_tick < target)
+            {
+                if (_count == 0)
+                {
+                    _now_tick = target;
+                    break;
+                }
+
+                // nothing in level 0, skip straight to the next cascade.
+                if (_level_empty(0))
+                {
+                    const uint64_t boundary = (_now_tick | (slots - 1));
+                    if (boundary >= target)
+                    {
+                        _now_tick = target;
+                        break;
+                    }
+                    _now_tick = boundary;
+                }
+
+                const uint64_t t = ++_now_tick;
+                for (size_t level = levels - 1; level > 0; --level)
+                {
+                    const uint64_t span = uint64_t{1} << (level * level_bits);
+                    if ((t & (span - 1)) == 0) _cascade(level, _slot_of(level, t));
+                }
+
+                fired += _fire(_slot_of(0, t), on_expire);
+            }
+
+            return fired;
+        }
+
+        /// @brief ms until the next timer may fire, for poll().
+        /// @details exact for timers in level 0, otherwise the time of the next cascade (never later than
+        /// the real expiry), so the loop may wake early but never late.
+        /// @param max_ms upper bound, -1 -> none.
+        /// @return 0 -> something is due, -1 -> nothing scheduled and no max_ms.
+        BANKER_NODISCARD int poll_timeout(const clock::time_point now, const int max_ms = -1) const
+        {
+            if (_count == 0) return max_ms;
+
+            const uint64_t next = _next_tick();
+            const uint64_t current = _tick_of(now);
+            if (next <= current) return 0;
+
+            const auto wait = std::chrono::ceil<std::chrono::milliseconds>(
+                _start + _resolution * static_cast<clock::rep>(next) - now).count();
+
+            const auto ms = static_cast<int>(std::clamp<decltype(wait)>(wait, 0, 1 << 30));
+            return max_ms < 0 ? ms : std::min(ms, max_ms);
+        }
+
+        BANKER_NODISCARD size_t size() const { return _count; }
+        BANKER_NODISCARD bool empty() const { return _count == 0; }
+
+        BANKER_NODISCARD clock::duration resolution() const { return _resolution; }
+
+    private:
+        struct node
+        {
+            uint64_t expires{0};
+            uint64_t user_data{0};
+            uint32_t prev{0};
+
+            /// @brief next in the slot list while scheduled, next free node while free.
+            uint32_t next{0};
+
+            /// @brief odd while scheduled.
+            uint32_t generation{0};
+        };
+
+        static constexpr uint32_t _no_node = ~0U;
+        static constexpr uint32_t _max_generation = ~0U - 1;
+
+        /// @brief one list head per slot, plus one for the list being fired.
+        static constexpr uint32_t _sentinel_count = levels * slots + 1;
+        static constexpr uint32_t _firing = levels * slots;
+
+        /// @brief furthest a timer is placed ahead, later ones are re-placed when their slot cascades.
+        /// @note one top level slot short of a full turn, so nothing lands in the current top slot.
+        static constexpr uint64_t _max_delta =
+            (uint64_t{1} << (levels * level_bits)) - (uint64_t{1} << ((levels - 1) * level_bits));
+
+        clock::duration         _resolution;
+        clock::time_point       _start;
+        uint64_t                _now_tick{0};
+
+        std::vector<node>       _nodes{};
+        uint32_t                _free_head{_no_node};
+        size_t                  _count{0};
+
+        /// @brief occupied slots per level.
+        uint64_t                _occupied[levels][slots / 64]{};
+
+        uint64_t _tick_of(const clock::time_point t) const
+        {
+            if (t <= _start) return 0;
+            return static_cast<uint64_t>((t - _start) / _resolution);
+        }
+
+        uint64_t _expiry(const clock::duration delay, const clock::time_point now) const
+        {
+            const auto ticks = delay <= clock::duration::zero()
+                ? clock::rep{0}
+                : (delay + _resolution - clock::duration(1)) / _resolution;
+
+            const uint64_t expires = _tick_of(now) + static_cast<uint64_t>(std::max<clock::rep>(ticks, 1));
+            return std::max(expires, _now_tick + 1);
+        }
+
+        static size_t _slot_of(const size_t level, const uint64_t tick)
+        {
+            return static_cast<size_t>(tick >> (level * level_bits)) & (slots - 1);
+        }
+
+        static uint32_t _sentinel(const size_t level, const size_t slot)
+        {
+            return static_cast<uint32_t>(level * slots + slot);
+        }
+
+        bool _level_empty(const size_t level) const
+        {
+            for (const uint64_t word : _occupied[level])
+                if (word != 0) return false;
+            return true;
+        }
+
+        uint32_t _resolve(const timer_id id) const
+        {
+            const auto index = static_cast<uint32_t>(id);
+            const auto generation = static_cast<uint32_t>(id >> 32);
+            if (index < _sentinel_count || index >= _nodes.size()) return _no_node;
+
+            const node& n = _nodes[index];
+            if (n.generation != generation || (n.generation & 1) == 0) return _no_node;
+            return index;
+        }
+
+        /// @brief puts a node in the slot matching its expiry.
+        void _link(const uint32_t index)
+        {
+            const uint64_t delta = std::min(_nodes[index].expires - _now_tick, _max_delta);
+            const uint64_t placed = _now_tick + delta;
+
+            size_t level = 0;
+            while (level + 1 < levels && delta >= (uint64_t{1} << ((level + 1) * level_bits))) ++level;
+
+            const size_t slot = _slot_of(level, placed);
+            _insert_before(_sentinel(level, slot), index);
+            _occupied[level][slot / 64] |= uint64_t{1} << (slot % 64);
+        }
+
+        void _insert_before(const uint32_t head, const uint32_t index)
+        {
+            node& n = _nodes[index];
+            n.next = head;
+            n.prev = _nodes[head].prev;
+            _nodes[n.prev].next = index;
+            _nodes[head].prev = index;
+        }
+
+        void _unlink(const uint32_t index)
+        {
+            node& n = _nodes[index];
+            const uint32_t prev = n.prev;
+            const uint32_t next = n.next;
+            _nodes[prev].next = next;
+            _nodes[next].prev = prev;
+
+            // the slot's list went empty, clear its bit.
+            if (prev == next && prev < _firing)
+            {
+                const size_t level = prev / slots;
+                const size_t slot = prev % slots;
+                _occupied[level][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+            }
+        }
+
+        void _release(const uint32_t index)
+        {
+            node& n = _nodes[index];
+            ++n.generation;     // even -> free. a node whose generation would wrap is retired.
+            --_count;
+            if (n.generation != _max_generation)
+            {
+                n.next = _free_head;
+                _free_head = index;
+            }
+        }
+
+        /// @brief moves a whole slot list onto 'head' (empty), the slot is left empty.
+        void _take_slot(const size_t level, const size_t slot, const uint32_t head)
+        {
+            const uint32_t s = _sentinel(level, slot);
+            if (_nodes[s].next == s) return;
+
+            _nodes[head].next = _nodes[s].next;
+            _nodes[head].prev = _nodes[s].prev;
+            _nodes[_nodes[head].next].prev = head;
+            _nodes[_nodes[head].prev].next = head;
+
+            _nodes[s].next = s;
+            _nodes[s].prev = s;
+            _occupied[level][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+        }
+
+        /// @brief re-places the timers of a higher level slot, they land in lower levels.
+        void _cascade(const size_t level, const size_t slot)
+        {
+            _take_slot(level, slot, _firing);
+            while (_nodes[_firing].next != _firing)
+            {
+                const uint32_t index = _nodes[_firing].next;
+                _unlink(index);
+                _link(index);
+            }
+        }
+
+        template<typename F>
+        size_t _fire(const size_t slot, F& on_expire)
+        {
+            // the list is detached first, callbacks can schedule into this slot or cancel what's left.
+            _take_slot(0, slot, _firing);
+
+            size_t fired = 0;
+            while (_nodes[_firing].next != _firing)
+            {
+                const uint32_t index = _nodes[_firing].next;
+                node& n = _nodes[index];
+                const timer_id id = (static_cast<timer_id>(n.generation) << 32) | index;
+                const uint64_t user_data = n.user_data;
+
+                _unlink(index);
+                _release(index);
+                ++fired;
+
+                on_expire(id, user_data);
+            }
+            return fired;
+        }
+
+        /// @brief first set slot at or after 'from' (wrapping), or slots.
+        size_t _first_occupied(const size_t level, const size_t from) const
+        {
+            const uint64_t* bits = _occupied[level];
+            const size_t first_word = from / 64;
+
+            for (size_t i = 0; i <= slots / 64; ++i)
+            {
+                const size_t word = (first_word + i) % (slots / 64);
+                uint64_t w = bits[word];
+                if (i == 0) w &= ~uint64_t{0} << (from % 64);
+                if (i == slots / 64) w &= (uint64_t{1} << (from % 64)) - 1;
+                if (w != 0) return word * 64 + static_cast<size_t>(std::countr_zero(w));
+            }
+            return slots;
+        }
+
+        /// @brief lower bound of the next tick a timer fires (or a cascade that may make one due).
+        uint64_t _next_tick() const
+        {
+            uint64_t best = ~uint64_t{0};
+            for (size_t level = 0; level < levels; ++level)
+            {
+                const size_t current = _slot_of(level, _now_tick);
+                const size_t slot = _first_occupied(level, (current + 1) % slots);
+                if (slot == slots) continue;
+
+                // above level 0 an occupied current slot holds timers a full turn ahead (delta wrapped
+                // onto it), it cascades when the level comes back around, not now.
+                uint64_t distance = (slot - current) & (slots - 1);
+                if (distance == 0 && level > 0) distance = slots;
+                const size_t shift = level * level_bits;
+                const uint64_t tick = ((_now_tick >> shift) + distance) << shift;
+                best = std::min(best, tick);
+            }
+            return best;
+        }
+    };
+}
+
+#endif //BANKER_TIMER_WHEEL_HPP
@@ -43,6 +43,30 @@ namespace banker::crypter
         bool operator!=(const mac& mac) const { return crypto_verify16(bytes,mac.bytes) == -1; };
     };
 
+    /// @brief an ephemeral X25519 key pair, made ahead of time (see keypair_pool).
+    struct keypair
+    {
+        key private_key{};
+        key public_key{};
+
+        /// @brief a fresh pair, the public key is derived with crypto_x25519_dirty_fast (the fixed
+        /// base comb, faster than a full ladder). the extra low order component it may carry is
+        /// cleared by the peer's clamped scalar, so shared secrets are the same.
+        static keypair generate()
+        {
+            keypair pair{};
+            crypto_rng::get_bytes(pair.private_key.bytes, sizeof(pair.private_key.bytes));
+            crypto_x25519_dirty_fast(pair.public_key.bytes, pair.private_key.bytes);
+            return pair;
+        }
+
+        void wipe()
+        {
+            crypto_wipe(private_key.bytes, sizeof(private_key.bytes));
+            crypto_wipe(public_key.bytes, sizeof(public_key.bytes));
+        }
+    };
+
     /// @brief encrypts anything, using KEY, and NONCE
     /// @param key shared key.
     /// @param data plaintext.
@@ -54,7 +78,7 @@ namespace banker::crypter
     inline void encrypt(
         const key &key,
         std::span<uint8_t> data,
-        const std::span<uint8_t> extra_data,
+        const std::span<const uint8_t> extra_data,
         const nonce& nonce,
         mac& mac)
     {
@@ -89,7 +113,7 @@ namespace banker::crypter
     inline bool decrypt(
         const key &key,
         std::span<uint8_t> data,
-        const std::span<uint8_t> extra_data,
+        const std::span<const uint8_t> extra_data,
         const nonce &nonce,
         const mac &mac)
     {
@@ -130,6 +154,15 @@ namespace banker::crypter
             _generate_public();
         }
 
+        /// @brief takes a ready made key pair, skips the key generation.
+        /// @param pair wiped after.
+        explicit handshake(keypair&& pair)
+        {
+            _private = pair.private_key;
+            _public = pair.public_key;
+            pair.wipe();
+        }
+
         ~handshake()
         {
             _wipe();
@@ -8,23 +8,43 @@
 #ifndef BANKER_CRYPTO_RNG_HPP
 #define BANKER_CRYPTO_RNG_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <mutex>
+
+#include "banker/vendor/monocypher/monocypher.hpp"
 
 #ifdef _WIN32
     #include <windows.h>
     #include <bcrypt.h>
 #else
-    #include <fstream>
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <unistd.h>
+    #if defined(__linux__)
+        #include <sys/random.h>
+    #endif
 #endif
 
 
 namespace banker
 {
-    /// @brief class wrapper for getting random generated bytes from the OS
-    ///
+    /// @brief class wrapper for getting cryptographically secure random bytes.
+    /// @details bytes come from a per thread ChaCha20 generator (fast key erasure: every refill
+    /// replaces the key with the first 32 bytes of its own output, and handed out bytes are wiped
+    /// from the buffer, so a leaked state can't reproduce earlier output).
+    /// it is seeded from the OS (getrandom(2) on linux, BCryptGenRandom on windows, /dev/urandom else),
+    /// reseeded every reseed_interval bytes, and wiped in the child after a fork so parent and child
+    /// never share a stream.
     class crypto_rng
     {
     public:
+        /// @brief bytes handed out before OS entropy is mixed in again.
+        static constexpr size_t reseed_interval = 1024 * 1024;
+
         /// @brief puts sizeof(T) number of bytes into the 'buffer'.
         /// @tparam T type of the buffer (uint16_t[16], uint8_t[32], ...).
         /// @param buffer mutable reference to the buffer.
@@ -38,39 +58,206 @@ namespace banker
         /// @brief puts 'size' number of bytes into the 'buffer'.
         /// @param buffer pointer to buffer.
         /// @param size how much to fill (no more than buffer size).
-        /// @return true -> valid, false -> invalid.
+        /// @return true -> valid, false -> invalid (the OS couldn't seed the generator).
         static bool get_bytes(void* buffer, const size_t size)
         {
             if (!buffer || size == 0) return false;
+            return _local().generate(static_cast<uint8_t*>(buffer), size);
+        }
+
+        /// @brief puts 'size' bytes straight from the OS into the 'buffer', skips the generator.
+        /// @return true -> valid, false -> invalid.
+        static bool get_os_bytes(void* buffer, const size_t size)
+        {
+            if (!buffer || size == 0) return false;
+            auto* out = static_cast<uint8_t*>(buffer);
 #ifdef _WIN32
             const NTSTATUS status = BCryptGenRandom(
              nullptr,
-             static_cast<PUCHAR>(buffer),
-             size,
+             out,
+             static_cast<ULONG>(size),
              BCRYPT_USE_SYSTEM_PREFERRED_RNG
             );
 
-            if (status != 0)
+            return status == 0;
+#else
+    #if defined(__linux__)
+            size_t filled = 0;
+            while (filled < size)
             {
-                return false;
+                const ssize_t r = ::getrandom(out + filled, size - filled, 0);
+                if (r < 0)
+                {
+                    if (errno == EINTR) continue;
+                    if (errno == ENOSYS) return _read_urandom(out + filled, size - filled);
+                    return false;
+                }
+                filled += static_cast<size_t>(r);
             }
-#else
-            std::ifstream urandom("/dev/urandom", std::ios::in | std::ios::binary);
-            if (!urandom)
+            return true;
+    #else
+            return _read_urandom(out, size);
+    #endif
+#endif
+        }
+
+        /// @brief makes the calling thread's generator reseed from the OS on its next use.
+        static void reseed()
+        {
+            _local().wipe();
+        }
+
+    private:
+        /// @brief the per thread generator.
+        class drbg
+        {
+        public:
+            drbg()  = default;
+            ~drbg() { wipe(); }
+
+            drbg(const drbg&)             = delete;
+            drbg& operator=(const drbg&)  = delete;
+
+            bool generate(uint8_t* out, size_t size)
+            {
+                if (_seeded && _fork_generation != _fork_counter().load(std::memory_order_acquire)) wipe();
+
+                while (size > 0)
+                {
+                    if (_available == 0 || _since_reseed >= reseed_interval)
+                    {
+                        if (!_refill()) return false;
+                    }
+
+                    const size_t n = size < _available ? size : _available;
+                    uint8_t* source = _buffer + (sizeof(_buffer) - _available);
+                    std::memcpy(out, source, n);
+                    crypto_wipe(source, n);
+
+                    _available -= n;
+                    _since_reseed += n;
+                    out += n;
+                    size -= n;
+                }
+                return true;
+            }
+
+            /// @brief drops the key and all buffered output, the next use reseeds.
+            void wipe()
             {
-                return false;
+                crypto_wipe(_key, sizeof(_key));
+                crypto_wipe(_buffer, sizeof(_buffer));
+                _available = 0;
+                _since_reseed = 0;
+                _seeded = false;
             }
 
-            urandom.read(static_cast<char*>(buffer), size);
-            if (!urandom || urandom.gcount() != static_cast<std::streamsize>(size))
+        private:
+            uint8_t _key[32]{};
+            uint8_t _buffer[512]{};
+            size_t _available{0};
+            size_t _since_reseed{0};
+            uint64_t _fork_generation{0};
+            bool _seeded{false};
+
+            bool _refill()
             {
-                return false;
+                if (!_seeded || _since_reseed >= reseed_interval)
+                {
+                    if (!_seed()) return false;
+                }
+
+                // one keystream block: the first 32 bytes become the next key, the rest is output.
+                static constexpr uint8_t nonce[8]{};
+                uint8_t stream[sizeof(_key) + sizeof(_buffer)];
+                crypto_chacha20_djb(stream, nullptr, sizeof(stream), _key, nonce, 0);
+
+                std::memcpy(_key, stream, sizeof(_key));
+                std::memcpy(_buffer, stream + sizeof(_key), sizeof(_buffer));
+                crypto_wipe(stream, sizeof(stream));
+
+                _available = sizeof(_buffer);
+                return true;
             }
+
+            /// @brief mixes fresh OS entropy into the key (the old key is kept in, so a weak
+            /// reseed can't make it worse).
+            bool _seed()
+            {
+                _install_fork_handler();
+
+                uint8_t entropy[32];
+                if (!get_os_bytes(entropy, sizeof(entropy))) return false;
+
+                if (_seeded)
+                {
+                    for (size_t i = 0; i < sizeof(_key); ++i) _key[i] ^= entropy[i];
+                }
+                else
+                {
+                    std::memcpy(_key, entropy, sizeof(_key));
+                }
+                crypto_wipe(entropy, sizeof(entropy));
+
+                _since_reseed = 0;
+                _seeded = true;
+                _fork_generation = _fork_counter().load(std::memory_order_acquire);
+                return true;
+            }
+        };
+
+        static drbg& _local()
+        {
+            thread_local drbg generator{};
+            return generator;
+        }
+
+        /// @brief bumped in the child after every fork, generators seeded before it wipe themselves.
+        static std::atomic<uint64_t>& _fork_counter()
+        {
+            static std::atomic<uint64_t> counter{0};
+            return counter;
+        }
+
+        static void _install_fork_handler()
+        {
+#ifndef _WIN32
+            static std::once_flag once{};
+            std::call_once(once, []
+            {
+                ::pthread_atfork(nullptr, nullptr, []
+                {
+                    _fork_counter().fetch_add(1, std::memory_order_acq_rel);
+                    _local().wipe();
+                });
+            });
 #endif
+        }
 
+#ifndef _WIN32
+        static bool _read_urandom(uint8_t* out, size_t size)
+        {
+            const int fd = ::open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+
+            while (size > 0)
+            {
+                const ssize_t r = ::read(fd, out, size);
+                if (r < 0 && errno == EINTR) continue;
+                if (r <= 0)
+                {
+                    ::close(fd);
+                    return false;
+                }
+                out += r;
+                size -= static_cast<size_t>(r);
+            }
+
+            ::close(fd);
             return true;
         }
+#endif
     };
 }
 
-#endif //BANKER_CRYPTO_RNG_HPP
\ No newline at end of file
+#endif //BANKER_CRYPTO_RNG_HPP
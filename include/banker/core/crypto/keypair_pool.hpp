@@ -0,0 +1,238 @@
+/* ================================== *\
+ @file     keypair_pool.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_KEYPAIR_POOL_HPP
+#define BANKER_KEYPAIR_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "banker/core/crypto/crypter.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::crypter
+{
+    /// @brief keeps a stock of ephemeral key pairs generated on background threads, so a burst of
+    /// handshakes only has to pop one instead of doing the scalar multiplication on the accept thread.
+    /// @details the threads top the stock up to 'capacity' whenever it drops below half. the same
+    /// threads help with generate_shared_secrets() batches, which go before refilling.
+    /// @code{.cpp}
+    /// keypair_pool keys{1024};
+    /// crypter::handshake hs = keys.take_handshake();
+    /// @endcode
+    class keypair_pool
+    {
+    public:
+        struct stats
+        {
+            /// @brief take() calls served from the stock.
+            uint64_t hits{0};
+
+            /// @brief take() calls that found the stock empty and generated on the caller.
+            uint64_t misses{0};
+        };
+
+    public:
+        /// @param capacity key pairs kept in stock.
+        /// @param thread_count background threads.
+        explicit keypair_pool(const size_t capacity = 256, const size_t thread_count = 1)
+            : _capacity(std::max<size_t>(capacity, 1))
+        {
+            _threads.reserve(thread_count);
+            for (size_t i = 0; i < thread_count; ++i)
+                _threads.emplace_back([this] { _thread_loop(); });
+        }
+
+        ~keypair_pool()
+        {
+            {
+                std::lock_guard lock(_mutex);
+                _stop = true;
+            }
+            _work_cv.notify_all();
+            _done_cv.notify_all();
+
+            for (auto& t : _threads)
+                if (t.joinable()) t.join();
+
+            for (keypair& pair : _stock) pair.wipe();
+        }
+
+        keypair_pool(const keypair_pool&)               = delete;
+        keypair_pool& operator=(const keypair_pool&)    = delete;
+
+        keypair_pool(keypair_pool&&)                    = delete;
+        keypair_pool& operator=(keypair_pool&&)         = delete;
+
+        /// @brief pops a key pair, generates one on the caller when the stock is empty.
+        BANKER_NODISCARD keypair take()
+        {
+            {
+                std::unique_lock lock(_mutex);
+                if (!_stock.empty())
+                {
+                    keypair pair = _stock.front();
+                    _stock.front().wipe();
+                    _stock.pop_front();
+                    ++_stats.hits;
+
+                    const bool refill = _needs_refill();
+                    lock.unlock();
+                    if (refill) _work_cv.notify_one();
+                    return pair;
+                }
+                ++_stats.misses;
+            }
+            _work_cv.notify_one();
+            return keypair::generate();
+        }
+
+        /// @brief a handshake made from take().
+        BANKER_NODISCARD handshake take_handshake()
+        {
+            return handshake{take()};
+        }
+
+        /// @brief does handshakes[i].generate_shared_secret(peers[i]) for every i, spread over
+        /// the pool's threads and the caller.
+        /// @param handshakes and peers have the same size.
+        void generate_shared_secrets(
+            const std::span<handshake> handshakes,
+            const std::span<const key> peers)
+        {
+            BANKER_ASSERT(handshakes.size() == peers.size());
+
+            batch b{handshakes, peers};
+            if (_threads.empty() || handshakes.size() < 2)
+            {
+                _work(b);
+                return;
+            }
+
+            {
+                std::lock_guard lock(_mutex);
+                _batch = &b;
+                ++_batch_generation;
+            }
+            _work_cv.notify_all();
+
+            _work(b);
+
+            std::unique_lock lock(_mutex);
+            _batch = nullptr;
+            _done_cv.wait(lock, [&] { return b.active == 0; });
+        }
+
+        /// @brief key pairs in stock right now.
+        BANKER_NODISCARD size_t available() const
+        {
+            std::lock_guard lock(_mutex);
+            return _stock.size();
+        }
+
+        BANKER_NODISCARD size_t capacity() const { return _capacity; }
+
+        BANKER_NODISCARD stats get_stats() const
+        {
+            std::lock_guard lock(_mutex);
+            return _stats;
+        }
+
+        /// @brief blocks until the stock is full (warm up before taking traffic).
+        void wait_full()
+        {
+            std::unique_lock lock(_mutex);
+            _done_cv.wait(lock, [this] { return _stop || _threads.empty() || _stock.size() >= _capacity; });
+        }
+
+    private:
+        struct batch
+        {
+            std::span<handshake> handshakes;
+            std::span<const key> peers;
+            std::atomic<size_t> cursor{0};
+
+            /// @brief threads working on it, guarded by the pool's mutex.
+            size_t active{0};
+        };
+
+        const size_t                _capacity;
+        std::vector<std::thread>    _threads{};
+        mutable std::mutex          _mutex{};
+        std::condition_variable     _work_cv{};
+        std::condition_variable     _done_cv{};
+        std::deque<keypair>         _stock{};
+        batch*                      _batch{nullptr};
+        uint64_t                    _batch_generation{0};
+        stats                       _stats{};
+        bool                        _stop{false};
+
+        static void _work(batch& b)
+        {
+            for (size_t i = b.cursor.fetch_add(1, std::memory_order_relaxed);
+                 i < b.handshakes.size();
+                 i = b.cursor.fetch_add(1, std::memory_order_relaxed))
+            {
+                b.handshakes[i].generate_shared_secret(b.peers[i]);
+            }
+        }
+
+        /// @note call with the mutex held.
+        BANKER_NODISCARD bool _needs_refill() const
+        {
+            return _stock.size() <= _capacity / 2;
+        }
+
+        void _thread_loop()
+        {
+            uint64_t seen_batch = 0;
+            const auto new_batch = [&] { return _batch != nullptr && _batch_generation != seen_batch; };
+
+            std::unique_lock lock(_mutex);
+            while (true)
+            {
+                _work_cv.wait(lock, [&] { return _stop || new_batch() || _needs_refill(); });
+                if (_stop) return;
+
+                if (new_batch())
+                {
+                    batch& b = *_batch;
+                    seen_batch = _batch_generation;
+                    ++b.active;
+                    lock.unlock();
+
+                    _work(b);
+
+                    lock.lock();
+                    --b.active;
+                    _done_cv.notify_all();
+                    continue;
+                }
+
+                // refill to capacity in one go, generating outside the lock, a batch goes first.
+                while (!_stop && !new_batch() && _stock.size() < _capacity)
+                {
+                    lock.unlock();
+                    keypair pair = keypair::generate();
+                    lock.lock();
+                    _stock.push_back(pair);
+                    pair.wipe();
+                }
+                _done_cv.notify_all();
+            }
+        }
+    };
+}
+
+#endif //BANKER_KEYPAIR_POOL_HPP
@@ -0,0 +1,211 @@
+/* ================================== *\
+ @file     resumption.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_RESUMPTION_HPP
+#define BANKER_RESUMPTION_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+#include "banker/core/crypto/crypter.hpp"
+#include "banker/core/crypto/crypto_rng.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::crypter
+{
+    /// @brief an opaque, server encrypted copy of a session secret, handed to the client after a
+    /// full handshake so it can reconnect without X25519.
+    /// @details [key id (4)][nonce (24)][mac (16)][secret (32) + issued at (8), encrypted].
+    /// the key id is authenticated as extra data.
+    struct ticket
+    {
+        static constexpr size_t size = 4 + sizeof(nonce) + sizeof(mac) + sizeof(key) + 8;
+
+        uint8_t bytes[size]{};
+    };
+
+    /// @brief the fresh random value each side contributes to a resumption.
+    using resume_nonce = key;
+
+    /// @brief the session key of a resumed connection: BLAKE2b keyed with the old secret over
+    /// both sides' fresh nonces, so every resumption gets its own key.
+    /// @code{.cpp}
+    /// // client: sends its ticket and a fresh nonce.
+    /// // server: issuer.redeem(ticket, old) -> sends a fresh nonce (and a new ticket).
+    /// key session = resumed_secret(old, client_nonce, server_nonce);   // same on both sides.
+    /// @endcode
+    inline key resumed_secret(
+        const key& old_secret,
+        const resume_nonce& client_nonce,
+        const resume_nonce& server_nonce)
+    {
+        static constexpr char label[] = "banker resume v1";
+
+        crypto_blake2b_ctx ctx;
+        crypto_blake2b_keyed_init(&ctx, sizeof(key), old_secret.bytes, sizeof(old_secret.bytes));
+        crypto_blake2b_update(&ctx, reinterpret_cast<const uint8_t*>(label), sizeof(label) - 1);
+        crypto_blake2b_update(&ctx, client_nonce.bytes, sizeof(client_nonce.bytes));
+        crypto_blake2b_update(&ctx, server_nonce.bytes, sizeof(server_nonce.bytes));
+
+        key result{};
+        crypto_blake2b_final(&ctx, result.bytes);
+        return result;
+    }
+
+    /// @brief server side: seals session secrets into tickets and opens them again.
+    /// @details tickets are sealed (crypto_aead_lock) with the newest ticket key. keys rotate every
+    /// rotation interval, at most 'max_keys' are kept, so a ticket stays redeemable for up to
+    /// rotation * max_keys (and never longer than lifetime). thread safe.
+    class ticket_issuer
+    {
+    public:
+        /// @param lifetime how long a ticket can be redeemed after it was issued.
+        /// @param rotation how long a ticket key is used for issuing.
+        /// @param max_keys ticket keys kept, older ones are wiped.
+        explicit ticket_issuer(
+            const std::chrono::seconds lifetime = std::chrono::hours(24),
+            const std::chrono::seconds rotation = std::chrono::hours(6),
+            const size_t max_keys = 5)
+            : _lifetime(static_cast<uint64_t>(lifetime.count())),
+              _rotation(static_cast<uint64_t>(rotation.count())),
+              _max_keys(max_keys == 0 ? 1 : max_keys)
+        {
+        }
+
+        ~ticket_issuer()
+        {
+            for (ticket_key& k : _keys) crypto_wipe(k.secret.bytes, sizeof(k.secret.bytes));
+        }
+
+        ticket_issuer(const ticket_issuer&)             = delete;
+        ticket_issuer& operator=(const ticket_issuer&)  = delete;
+
+        /// @brief seals 'secret' into a ticket.
+        /// @param now seconds since the epoch.
+        BANKER_NODISCARD ticket issue(const key& secret, const uint64_t now = clock_now())
+        {
+            std::lock_guard lock(_mutex);
+
+            if (_keys.empty() || now >= _keys.back().created + _rotation) _rotate(now);
+            const ticket_key& k = _keys.back();
+
+            ticket t{};
+            uint8_t* id = t.bytes;
+            uint8_t* n = id + 4;
+            uint8_t* m = n + sizeof(nonce);
+            uint8_t* body = m + sizeof(mac);
+
+            std::memcpy(id, &k.id, 4);
+            crypto_rng::get_bytes(n, sizeof(nonce));
+            std::memcpy(body, secret.bytes, sizeof(secret.bytes));
+            std::memcpy(body + sizeof(key), &now, 8);
+
+            crypto_aead_lock(body, m, k.secret.bytes, n, id, 4, body, sizeof(key) + 8);
+            return t;
+        }
+
+        /// @brief opens a ticket.
+        /// @param secret set to the sealed session secret on success.
+        /// @param now seconds since the epoch.
+        /// @return true -> valid, false -> forged, expired or its key rotated out.
+        BANKER_NODISCARD bool redeem(const ticket& t, key& secret, const uint64_t now = clock_now())
+        {
+            uint32_t id = 0;
+            std::memcpy(&id, t.bytes, 4);
+
+            std::lock_guard lock(_mutex);
+
+            const ticket_key* k = _find(id);
+            if (k == nullptr) return false;
+
+            const uint8_t* n = t.bytes + 4;
+            const uint8_t* m = n + sizeof(nonce);
+            const uint8_t* sealed = m + sizeof(mac);
+
+            uint8_t body[sizeof(key) + 8];
+            if (crypto_aead_unlock(body, m, k->secret.bytes, n, t.bytes, 4, sealed, sizeof(body)) != 0)
+                return false;
+
+            uint64_t issued = 0;
+            std::memcpy(&issued, body + sizeof(key), 8);
+
+            const bool fresh = issued <= now && now - issued <= _lifetime;
+            if (fresh) std::memcpy(secret.bytes, body, sizeof(key));
+
+            crypto_wipe(body, sizeof(body));
+            return fresh;
+        }
+
+        /// @brief starts a new ticket key now, drops the oldest if over max_keys.
+        void rotate(const uint64_t now = clock_now())
+        {
+            std::lock_guard lock(_mutex);
+            _rotate(now);
+        }
+
+        /// @brief ticket keys currently kept.
+        BANKER_NODISCARD size_t key_count() const
+        {
+            std::lock_guard lock(_mutex);
+            return _keys.size();
+        }
+
+        /// @brief seconds since the epoch.
+        static uint64_t clock_now()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        }
+
+    private:
+        struct ticket_key
+        {
+            uint32_t id{0};
+            uint64_t created{0};
+            key secret{};
+        };
+
+        const uint64_t          _lifetime;
+        const uint64_t          _rotation;
+        const size_t            _max_keys;
+
+        mutable std::mutex      _mutex{};
+        std::deque<ticket_key>  _keys{};
+        uint32_t                _next_id{0};
+
+        void _rotate(const uint64_t now)
+        {
+            // random start, so ids of a restarted server don't match tickets of the old one.
+            if (_keys.empty() && _next_id == 0) crypto_rng::get(_next_id);
+
+            ticket_key k{};
+            k.id = _next_id++;
+            k.created = now;
+            crypto_rng::get(k.secret.bytes);
+            _keys.push_back(k);
+            crypto_wipe(k.secret.bytes, sizeof(k.secret.bytes));
+
+            while (_keys.size() > _max_keys)
+            {
+                crypto_wipe(_keys.front().secret.bytes, sizeof(_keys.front().secret.bytes));
+                _keys.pop_front();
+            }
+        }
+
+        const ticket_key* _find(const uint32_t id) const
+        {
+            for (const ticket_key& k : _keys)
+                if (k.id == id) return &k;
+            return nullptr;
+        }
+    };
+}
+
+#endif //BANKER_RESUMPTION_HPP
@@ -0,0 +1,112 @@
+/* ================================== *\
+ @file     soa_storage.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_SOA_STORAGE_HPP
+#define BANKER_SOA_STORAGE_HPP
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "banker/shared/compat.hpp"
+
+namespace banker::networker
+{
+    /// @brief dense_storage split into one array per field (structure of arrays).
+    /// @details same swap remove indices as dense_storage, but a sweep over one field
+    /// (fds, pending bytes, ...) only pulls that field's array through the cache.
+    /// @code{.cpp}
+    /// soa_storage<socket_t, size_t, connection_state> conns{};
+    /// const size_t i = conns.add(fd, 0, connection_state{});
+    /// for (size_t pending : conns.field<1>()) ...
+    /// @endcode
+    template<typename... Fields>
+    class soa_storage
+    {
+        static_assert(sizeof...(Fields) > 0, "soa_storage needs at least one field");
+        static_assert((!std::is_same_v<Fields, bool> && ...), "std::vector<bool> isn't contiguous, use uint8_t");
+
+    public:
+        template<size_t I>
+        using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+        /// @brief references to every field of one item.
+        using row = std::tuple<Fields&...>;
+
+    public:
+        size_t add(Fields... values)
+        {
+            _for_each_field([&]<size_t... I>(std::index_sequence<I...>)
+            {
+                (std::get<I>(_fields).push_back(std::move(values)), ...);
+            });
+            return size() - 1;
+        }
+
+        void remove(const size_t index)
+        {
+            if (index >= size()) return;
+            _for_each_field([&]<size_t... I>(std::index_sequence<I...>)
+            {
+                (_swap_remove(std::get<I>(_fields), index), ...);
+            });
+        }
+
+        row operator[](const size_t index)
+        {
+            return std::apply([index](auto&... arrays) { return row{arrays[index]...}; }, _fields);
+        }
+
+        /// @brief the whole array of field I.
+        template<size_t I>
+        std::span<field_type<I>> field() { return std::get<I>(_fields); }
+
+        template<size_t I>
+        std::span<const field_type<I>> field() const { return std::get<I>(_fields); }
+
+        template<size_t I>
+        field_type<I>& get(const size_t index) { return std::get<I>(_fields)[index]; }
+
+        template<size_t I>
+        const field_type<I>& get(const size_t index) const { return std::get<I>(_fields)[index]; }
+
+        BANKER_NODISCARD size_t size() const { return std::get<0>(_fields).size(); }
+        BANKER_NODISCARD bool empty() const { return std::get<0>(_fields).empty(); }
+
+        void reserve(const size_t count)
+        {
+            std::apply([count](auto&... arrays) { (arrays.reserve(count), ...); }, _fields);
+        }
+
+        void clear()
+        {
+            std::apply([](auto&... arrays) { (arrays.clear(), ...); }, _fields);
+        }
+
+    private:
+        std::tuple<std::vector<Fields>...> _fields{};
+
+        template<typename F>
+        static void _for_each_field(F&& f)
+        {
+            f(std::index_sequence_for<Fields...>{});
+        }
+
+        template<typename T>
+        static void _swap_remove(std::vector<T>& array, const size_t index)
+        {
+            if (index != array.size() - 1)
+                array[index] = std::move(array.back());
+            array.pop_back();
+        }
+    };
+}
+
+#endif //BANKER_SOA_STORAGE_HPP
@@ -9,7 +9,6 @@
 #define BANKER_STABLE_STORAGE_HPP
 
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 
 #include "banker/shared/compat.hpp"
@@ -19,6 +18,11 @@ namespace banker::networker
     using stable_id = uint64_t;
     static constexpr stable_id invalid_id = ~0ULL;
 
+    /// @brief dense storage with ids that stay valid while items move around (generational slot map).
+    /// @details items are packed in a vector (swap remove), an id is a slot index (low 32 bits)
+    /// and the slot's generation (high 32 bits). get() is one array index and a generation compare.
+    /// removing bumps the generation, so old ids of a reused slot just stop resolving.
+    /// freed slots are reused through a free list.
     template<typename T>
     class stable_storage
     {
@@ -28,56 +32,138 @@ namespace banker::networker
 
         stable_id add(T&& value)
         {
-            const stable_id id = _next_id++;
-            _items.push_back(std::move(value));
-            const size_t index = _items.size() - 1;
+            uint32_t slot_index;
+            if (_free_head != _no_slot)
+            {
+                slot_index = _free_head;
+                _free_head = _slots[slot_index].index;
+            }
+            else
+            {
+                slot_index = static_cast<uint32_t>(_slots.size());
+                _slots.push_back(slot{});
+            }
 
-            _id_to_index[id] = index;
+            slot& s = _slots[slot_index];
+            ++s.generation;     // odd -> in use.
+            s.index = static_cast<uint32_t>(_items.size());
+
+            const stable_id id = _make_id(slot_index, s.generation);
+            _items.push_back(std::move(value));
             _index_to_id.push_back(id);
             return id;
         }
 
         void remove(const stable_id id)
         {
-            const auto it = _id_to_index.find(id);
-            if (it == _id_to_index.end()) return;
+            slot* s = _resolve(id);
+            if (s == nullptr) return;
 
-            size_t index = it->second;
-            size_t last = _items.size() - 1;
+            const size_t index = s->index;
+            const size_t last = _items.size() - 1;
 
             BANKER_LIKELY if (index != last)
             {
                 _items[index] = std::move(_items[last]);
                 const stable_id moved_id = _index_to_id[last];
-                _id_to_index[moved_id] = index;
+                _slots[_slot_of(moved_id)].index = static_cast<uint32_t>(index);
                 _index_to_id[index] = moved_id;
             }
 
             _items.pop_back();
             _index_to_id.pop_back();
-            _id_to_index.erase(id);
+
+            // even -> free. a slot whose generation would wrap is retired instead of reused.
+            ++s->generation;
+            if (s->generation != _max_generation)
+            {
+                s->index = _free_head;
+                _free_head = _slot_of(id);
+            }
         }
 
         T* get(const stable_id id)
         {
-            const auto it = _id_to_index.find(id);
-            return (it != _id_to_index.end()) ? &_items[it->second] : nullptr;
+            const slot* s = _resolve(id);
+            return s != nullptr ? &_items[s->index] : nullptr;
         }
 
+        const T* get(const stable_id id) const
+        {
+            const slot* s = _resolve(id);
+            return s != nullptr ? &_items[s->index] : nullptr;
+        }
+
+        BANKER_NODISCARD bool contains(const stable_id id) const { return _resolve(id) != nullptr; }
+
         T& raw_at(size_t index) { return _items[index]; }
 
         stable_id id_at(const size_t index) const { return _index_to_id[index]; }
 
         size_t size() const { return _items.size(); }
 
+        BANKER_NODISCARD bool empty() const { return _items.empty(); }
+
         stable_id index_to_id(const size_t index) const { return _index_to_id[index]; }
 
+        void reserve(const size_t count)
+        {
+            _items.reserve(count);
+            _index_to_id.reserve(count);
+            _slots.reserve(count);
+        }
+
+        /// @brief removes every item, all ids handed out so far stop resolving.
+        void clear()
+        {
+            while (!_index_to_id.empty()) remove(_index_to_id.back());
+        }
+
+        auto begin() { return _items.begin(); }
+        auto end() { return _items.end(); }
+
     private:
-        stable_id _next_id{0};
+        struct slot
+        {
+            /// @brief odd while in use.
+            uint32_t generation{0};
+
+            /// @brief index into _items while in use, next free slot while free.
+            uint32_t index{0};
+        };
+
+        static constexpr uint32_t _no_slot = ~0U;
+        static constexpr uint32_t _max_generation = ~0U - 1;
+
         std::vector<T> _items;
         std::vector<stable_id> _index_to_id;
-        std::unordered_map<stable_id, size_t> _id_to_index;
+        std::vector<slot> _slots;
+        uint32_t _free_head{_no_slot};
+
+        static stable_id _make_id(const uint32_t slot_index, const uint32_t generation)
+        {
+            return (static_cast<stable_id>(generation) << 32) | slot_index;
+        }
+
+        static uint32_t _slot_of(const stable_id id) { return static_cast<uint32_t>(id); }
+
+        static uint32_t _generation_of(const stable_id id) { return static_cast<uint32_t>(id >> 32); }
+
+        slot* _resolve(const stable_id id)
+        {
+            return const_cast<slot*>(static_cast<const stable_storage*>(this)->_resolve(id));
+        }
+
+        const slot* _resolve(const stable_id id) const
+        {
+            const uint32_t slot_index = _slot_of(id);
+            if (slot_index >= _slots.size()) return nullptr;
+
+            const slot& s = _slots[slot_index];
+            if (s.generation != _generation_of(id) || (s.generation & 1) == 0) return nullptr;
+            return &s;
+        }
     };
 }
 
-#endif //BANKER_STABLE_STORAGE_HPP
\ No newline at end of file
+#endif //BANKER_STABLE_STORAGE_HPP
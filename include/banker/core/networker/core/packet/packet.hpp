@@ -14,14 +14,30 @@
 #include <cstdint>
 #include <cstring>
 
+#include "banker/common/containers/buffer_pool.hpp"
+#include "banker/core/networker/core/packet/packet_view.hpp"
 #include "banker/shared/compat.hpp"
 #include "banker/shared/program_macros.hpp"
 
 namespace banker::networker
 {
-    class packet
+    /// @brief byte packet with typed write() / read().
+    /// @tparam Allocator allocator of the byte storage, see packet and pooled_packet.
+    template<typename Allocator = std::allocator<uint8_t>>
+    class basic_packet
     {
     public:
+        /// @brief the byte storage of this packet, also what serialize_to_stream() returns.
+        using buffer_type = std::vector<uint8_t, Allocator>;
+
+        /// @brief see networker::varint.
+        template<typename T>
+        using varint = networker::varint<T>;
+
+        /// @brief see networker::delta_sequence.
+        template<typename T>
+        using delta_sequence = networker::delta_sequence<T>;
+
         /// @brief the packet's header, this will be prepended to all packets when using its serialization,
         /// and should be prepended when manually done.
         struct header
@@ -29,45 +45,49 @@ namespace banker::networker
             uint32_t size{0};
         };
     public:
-        explicit packet( std::span<uint8_t> data ) : _data(data.begin(), data.end()) {}
+        explicit basic_packet( std::span<uint8_t> data ) : _data(data.begin(), data.end()) {}
 
-        packet() = default;
-        ~packet() = default;
+        basic_packet() = default;
+        ~basic_packet() = default;
 
-        packet( const packet &rhs ) = default;
-        packet( packet &&rhs ) = default;
-        packet &operator=( const packet &rhs ) = default;
-        packet &operator=( packet &&rhs ) = default;
+        basic_packet( const basic_packet &rhs ) = default;
+        basic_packet( basic_packet &&rhs ) = default;
+        basic_packet &operator=( const basic_packet &rhs ) = default;
+        basic_packet &operator=( basic_packet &&rhs ) = default;
 
-        explicit packet( std::vector<uint8_t>&& data ) noexcept
+        explicit basic_packet( buffer_type&& data ) noexcept
             : _data(std::move(data)) {}
 
-        explicit packet( std::span<const uint8_t> data )
+        explicit basic_packet( std::span<const uint8_t> data )
             : _data(data.begin(), data.end()) {}
 
-        explicit packet( const uint8_t *data, const size_t size )
-            : _data( std::vector<uint8_t>(data, data + size) ) {}
+        explicit basic_packet( const uint8_t *data, const size_t size )
+            : _data( buffer_type(data, data + size) ) {}
 
 
         /// @brief serializes the packet for sending over TCP / stream (adds a 4-byte length prefix that is .get_data().size())
-        [[nodiscard]] std::vector<uint8_t> serialize_to_stream() const
+        [[nodiscard]] buffer_type serialize_to_stream() const
         {
-            std::vector<uint8_t> buffer;
+            buffer_type buffer;
+            buffer.reserve(sizeof(header) + _data.size());
             _serialize_into(buffer);
             return buffer;
         }
 
         /// @brief serializes the packet into an already exisitng stream.
         /// @param stream ref to stream.
+        template<typename StreamAllocator>
         void serialize_into_stream(
-            std::vector<uint8_t>& stream) const
+            std::vector<uint8_t, StreamAllocator>& stream) const
         {
             _serialize_into(stream);
         }
 
         /// @brief tries to deserialize, returns invalid packet if it can't deserialize.
         /// packet validness can be checked with ::is_valid()
-        static packet deserialize(
+        /// @note copies the payload and erases it from the front of the stream, use frame_reader
+        /// to go over many frames without copying.
+        static basic_packet deserialize(
             std::vector<uint8_t>& stream)
         {
             header h = _deserialize_header(stream);
@@ -75,7 +95,7 @@ namespace banker::networker
             if (h.size == 0) return {};
             if (stream.size() < (h.size + sizeof(header))) return {};
 
-            packet pkt;
+            basic_packet pkt;
             pkt._data.insert(pkt._data.end(),
                              stream.begin() + sizeof(header),
                              stream.begin() + sizeof(header) + h.size);
@@ -91,13 +111,109 @@ namespace banker::networker
         /// @param v the value to serialize.
         /// @return (ignore)
         template<typename T>
-        std::enable_if_t<std::is_trivially_copyable_v<T>>
-        write(T v) noexcept
+        std::enable_if_t<fields::is_raw_v<T>>
+        write(T v)
+        {
+            _append(&v, sizeof(T));
+        }
+
+        /// @brief writes a struct that uses BANKER_FIELDS, field by field in the listed order.
+        /// @details reserves once, and all leading fixed size fields are copied into one block.
+        template<typename T>
+        std::enable_if_t<fields::has_fields_v<T>>
+        write(const T& v)
         {
-            const auto raw_v = reinterpret_cast<const uint8_t*>(&v);
-            for (size_t b = 0; b < sizeof(T); b++)
+            fields::check<T>();
+            reserve(encoded_size(v));
+
+            constexpr size_t prefix_count = fields::fixed_prefix_count<T>();
+            constexpr size_t prefix_size = fields::fixed_prefix_size<T>();
+
+            const auto tied = v.banker_fields();
+            const size_t at = _data.size();
+            _data.resize(at + prefix_size);
+            uint8_t* out = _data.data() + at;
+
+            const auto write_field = [&]<size_t I>()
+            {
+                if BANKER_CONSTEXPR (I < prefix_count) _write_fixed(std::get<I>(tied), out);
+                else write(std::get<I>(tied));
+            };
+
+            [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                (write_field.template operator()<I>(), ...);
+            }(std::make_index_sequence<fields::count<T>>{});
+        }
+
+        /// @brief writes an integer as a varint, see networker::varint.
+        template<typename T>
+        void write(const varint<T> v)
+        {
+            uint8_t bytes[encoding::max_varint_size];
+            _append(bytes, encoding::encode_varint(encoding::to_wire(v.value), bytes));
+        }
+
+        /// @brief writes integers as varint differences, see networker::delta_sequence.
+        template<typename T>
+        void write(const delta_sequence<T>& sequence)
+        {
+            const size_t at = _data.size();
+            _data.resize(at + sequence.encoded_size());
+            (void)sequence.encode(_data.data() + at);
+        }
+
+        /// @brief reserves room for 'bytes' more bytes, so the writes after it don't reallocate.
+        /// @note use encoded_size() to find out how much a value takes.
+        void reserve(const size_t bytes)
+        {
+            _data.reserve(_data.size() + bytes);
+        }
+
+        /// @brief how many bytes write(v) adds, handy for reserve().
+        template<typename T>
+        static size_t encoded_size(const T& v)
+        {
+            if BANKER_CONSTEXPR (std::is_same_v<T, std::string>)
             {
-                _data.push_back(raw_v[b]);
+                return sizeof(uint32_t) + v.size();
+            }
+            else if BANKER_CONSTEXPR (std::is_same_v<T, basic_packet>)
+            {
+                return sizeof(uint32_t) + v.get_data().size();
+            }
+            else if BANKER_CONSTEXPR (_is_varint<T>::value)
+            {
+                return encoding::varint_size(encoding::to_wire(v.value));
+            }
+            else if BANKER_CONSTEXPR (_is_delta_sequence<T>::value)
+            {
+                return v.encoded_size();
+            }
+            else if BANKER_CONSTEXPR (fields::has_fields_v<T>)
+            {
+                if BANKER_CONSTEXPR (fields::fixed_size<T>() != 0) return fields::fixed_size<T>();
+
+                return std::apply([](const auto&... field)
+                {
+                    return (size_t{0} + ... + encoded_size(field));
+                }, v.banker_fields());
+            }
+            else if BANKER_CONSTEXPR (_is_bulk_sequence<T>::value)
+            {
+                return sizeof(uint32_t) + v.size() * sizeof(typename T::value_type);
+            }
+            else if BANKER_CONSTEXPR (_is_vector<T>::value)
+            {
+                size_t size = sizeof(uint32_t);
+                for (const auto& elem : v) size += encoded_size(elem);
+                return size;
+            }
+            else
+            {
+                static_assert(std::is_trivially_copyable_v<T>,
+                              "T must be trivially copyable, std::string or std::vector");
+                return sizeof(T);
             }
         }
 
@@ -110,7 +226,7 @@ namespace banker::networker
 
         /// generates a header from combined packets. useful for manually combining packets.
         /// @param packets non owning view of packets.
-        static header generate_header_from(const std::span<packet> packets)
+        static header generate_header_from(const std::span<basic_packet> packets)
         {
             assert(!packets.empty());
 
@@ -124,7 +240,7 @@ namespace banker::networker
 
         /// generates a header from combined packets. useful for manually combining packets.
         /// @param packets non owning view of packets.
-        static header generate_header_from(const std::span< packet* > packets)
+        static header generate_header_from(const std::span< basic_packet* > packets)
         {
             assert(!packets.empty());
 
@@ -140,7 +256,7 @@ namespace banker::networker
         [[nodiscard]] header generate_header_net() const
         {
             header h = generate_header();
-            return packet::header_to_net(h);
+            return basic_packet::header_to_net(h);
         }
 
         /// @brief user order header converted to network order header.
@@ -161,6 +277,16 @@ namespace banker::networker
             return h;
         }
 
+        /// @brief takes the payload out of the packet (no header), leaving it empty.
+        /// @note used to queue the payload for sending without copying it.
+        [[nodiscard]] buffer_type release()
+        {
+            buffer_type data = std::move(_data);
+            _data.clear();
+            _read_offset = 0;
+            return data;
+        }
+
         /// @brief clears the packet fully.
         void clear()
         {
@@ -184,39 +310,10 @@ namespace banker::networker
         template<typename T>
         T read(bool* valid = nullptr)
         {
-            if (valid != nullptr) *valid = true;
-
-            if BANKER_CONSTEXPR (std::is_same_v<T, std::string>)
+            if BANKER_CONSTEXPR (std::is_same_v<T, basic_packet>)
             {
-                const auto len = this->read<uint32_t>(valid);
-                if (!_can_read_check(len))
-                {
-                    if (!_valid_check(valid, false)) { BANKER_TERMINATE("BAD PACKET (UNDERFLOW)"); }
-                    return {};
-                }
-                std::string result(reinterpret_cast<const char*>(_data.data() + _read_offset), len);
-                _read_offset += len;
-                return result;
-            }
-            else if BANKER_CONSTEXPR (is_vector<T>::value)
-            {
-                using elem_t = typename T::value_type;
-
-                auto len = read<uint32_t>(valid);
-                if (!_can_read_check(len))
-                {
-                    if (!_valid_check(valid, false)) { BANKER_TERMINATE("BAD PACKET (UNDERFLOW)"); }
-                    return {};
-                }
-
-                T vec(len);
-                for (uint32_t i = 0; i < len; ++i)
-                    vec[i] = this->read<elem_t>(valid);
+                if (valid != nullptr) *valid = true;
 
-                return vec;
-            }
-            else if BANKER_CONSTEXPR (std::is_same_v<T, packet>)
-            {
                 const auto len = this->read<uint32_t>(valid);
                 if (!_can_read_check(len))
                 {
@@ -224,25 +321,26 @@ namespace banker::networker
                     return {};
                 }
 
-                return packet(this->get_remaining_data().data(), len);
+                basic_packet result(this->get_remaining_data().data(), len);
+                _read_offset += len;
+                return result;
             }
             else
             {
-                static_assert(std::is_trivially_copyable_v<T>,
-                              "T must be trivially copyable or std::string");
-
-                if (!_can_read_check(sizeof(T)))
-                {
-                    if (!_valid_check(valid, false)) { BANKER_TERMINATE("BAD PACKET (UNDERFLOW)"); }
-                    return {};
-                }
-                T value;
-                std::memcpy(&value, _data.data() + _read_offset, sizeof(T));
-                _read_offset += sizeof(T);
-                return value;
+                // views handed out by read (string_view, span, packet_view) point into this packet.
+                packet_view reader(get_data(), _read_offset);
+                T result = reader.read<T>(valid);
+                _read_offset = reader.read_offset();
+                return result;
             }
         }
 
+        /// @brief a read only view of the packet, starting at the current read offset.
+        [[nodiscard]] packet_view view() const
+        {
+            return packet_view(get_data(), _read_offset);
+        }
+
         /// @brief returns a view of the internal data.
         /// @return const view of data.
         /// @note don't worry of the size of send packet doesn't equal the received packet size,
@@ -287,21 +385,23 @@ namespace banker::networker
         }
 
     private:
-        std::vector<uint8_t> _data{};
+        buffer_type _data{};
 
         /// @brief pop pointer, stars at 0 increased dynamically based on reads.
         ///
         size_t _read_offset{};
 
+        template<typename StreamAllocator>
         void _serialize_into(
-            std::vector<uint8_t>& stream) const
+            std::vector<uint8_t, StreamAllocator>& stream) const
         {
             _serialize_header_into(stream);
             stream.insert(stream.end(), _data.begin(), _data.end());
         }
 
+        template<typename StreamAllocator>
         void _serialize_header_into(
-            std::vector<uint8_t>& stream) const
+            std::vector<uint8_t, StreamAllocator>& stream) const
         {
             const header h = generate_header_net();
             const auto* h_ptr = reinterpret_cast<const uint8_t*>(&h);
@@ -341,11 +441,57 @@ namespace banker::networker
             return true;
         }
 
+        /// @brief appends raw bytes with a single copy.
+        void _append(const void* bytes, const size_t size)
+        {
+            const auto* ptr = static_cast<const uint8_t*>(bytes);
+            _data.insert(_data.end(), ptr, ptr + size);
+        }
+
         template<typename T>
-        struct is_vector : std::false_type {};
+        struct _is_vector : std::false_type {};
 
         template<typename T, typename Alloc>
-        struct is_vector<std::vector<T, Alloc>> : std::true_type {};
+        struct _is_vector<std::vector<T, Alloc>> : std::true_type {};
+
+        template<typename T>
+        struct _is_varint : std::false_type {};
+
+        template<typename T>
+        struct _is_varint<varint<T>> : std::true_type {};
+
+        template<typename T>
+        struct _is_delta_sequence : std::false_type {};
+
+        template<typename T>
+        struct _is_delta_sequence<delta_sequence<T>> : std::true_type {};
+
+        /// @brief vectors / spans whose elements can be copied in one go.
+        template<typename T>
+        struct _is_bulk_sequence : std::false_type {};
+
+        template<typename T, typename Alloc>
+        struct _is_bulk_sequence<std::vector<T, Alloc>>
+            : std::bool_constant<fields::is_raw_v<T> && !std::is_same_v<T, bool>> {};
+
+        template<typename T, size_t Extent>
+        struct _is_bulk_sequence<std::span<T, Extent>>
+            : std::bool_constant<fields::is_raw_v<std::remove_cv_t<T>>> {};
+
+        /// @brief copies a fixed size value to 'out' and moves 'out' past it, no size checks.
+        template<typename F>
+        static void _write_fixed(const F& v, uint8_t*& out)
+        {
+            if BANKER_CONSTEXPR (fields::has_fields_v<F>)
+            {
+                std::apply([&out](const auto&... field) { (_write_fixed(field, out), ...); }, v.banker_fields());
+            }
+            else
+            {
+                std::memcpy(out, &v, sizeof(F));
+                out += sizeof(F);
+            }
+        }
 
     public:
         /// write string spec.
@@ -358,7 +504,7 @@ namespace banker::networker
             _data.insert(_data.end(), v.begin(), v.end());
         }
 
-        void write(const packet& v)
+        void write(const basic_packet& v)
         {
             const auto len = static_cast<uint32_t>(v.get_data().size());
             this->write(len);
@@ -368,14 +514,33 @@ namespace banker::networker
         /// write vector<T> spec.
         /// see @ref banker::networker::packet::write for more info.
         /// @param vec vector to write from.
-        template<typename T>
-        void write(const std::vector<T>& vec)
+        template<typename T, typename Alloc>
+        void write(const std::vector<T, Alloc>& vec)
         {
             const auto len = static_cast<uint32_t>(vec.size());
             write(len);
 
-            for (const auto& elem : vec)
-                write(elem);
+            if BANKER_CONSTEXPR (_is_bulk_sequence<std::vector<T, Alloc>>::value)
+            {
+                _append(vec.data(), vec.size() * sizeof(T));
+            }
+            else
+            {
+                for (const auto& elem : vec)
+                    write(elem);
+            }
+        }
+
+        /// write span<T> spec, same layout as a vector so it can be read back as one.
+        /// @param elems trivially copyable elements, written with a single copy.
+        template<typename T, size_t Extent>
+        void write(const std::span<T, Extent> elems)
+        {
+            static_assert(fields::is_raw_v<std::remove_cv_t<T>>,
+                          "span elements must be trivially copyable (without BANKER_FIELDS)");
+
+            write(static_cast<uint32_t>(elems.size()));
+            _append(elems.data(), elems.size_bytes());
         }
 
         void insert_bytes(const std::span<const uint8_t>& bytes)
@@ -383,6 +548,13 @@ namespace banker::networker
             _data.insert(_data.end(), bytes.begin(), bytes.end());
         }
     };
+
+    /// @brief packet on the regular heap.
+    using packet = basic_packet<>;
+
+    /// @brief packet drawing from the thread's buffer_pool, serialize_to_stream() gives pooled_bytes
+    /// that stream_socket::enqueue() takes without a copy.
+    using pooled_packet = basic_packet<pool_allocator<uint8_t>>;
 }
 
 
@@ -0,0 +1,205 @@
+/* ================================== *\
+ @file     packet_encodings.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_PACKET_ENCODINGS_HPP
+#define BANKER_PACKET_ENCODINGS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "banker/core/networker/core/packet/packet_fields.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::networker
+{
+    namespace encoding
+    {
+        /// @brief most bytes a 64 bit varint takes.
+        static constexpr size_t max_varint_size = 10;
+
+        /// @brief maps signed to unsigned so small magnitudes stay small (0, -1, 1, -2 -> 0, 1, 2, 3).
+        BANKER_NODISCARD constexpr uint64_t zigzag_encode(const int64_t v)
+        {
+            return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+        }
+
+        BANKER_NODISCARD constexpr int64_t zigzag_decode(const uint64_t v)
+        {
+            return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+        }
+
+        /// @brief bytes encode_varint() takes for 'v'.
+        BANKER_NODISCARD constexpr size_t varint_size(uint64_t v)
+        {
+            size_t size = 1;
+            while (v >= 0x80) { v >>= 7; ++size; }
+            return size;
+        }
+
+        /// @brief LEB128, 7 bits per byte, low bits first.
+        /// @param out at least max_varint_size bytes.
+        /// @return bytes written.
+        inline size_t encode_varint(uint64_t v, uint8_t* out)
+        {
+            size_t size = 0;
+            while (v >= 0x80)
+            {
+                out[size++] = static_cast<uint8_t>(v | 0x80);
+                v >>= 7;
+            }
+            out[size++] = static_cast<uint8_t>(v);
+            return size;
+        }
+
+        /// @brief reads a LEB128 varint.
+        /// @param data bytes to read from.
+        /// @param offset where to start, moved past the varint on success.
+        /// @param out the value.
+        /// @return true -> succeeded, false -> failed (truncated or longer than max_varint_size).
+        inline bool decode_varint(
+            const std::span<const uint8_t> data,
+            size_t& offset,
+            uint64_t& out)
+        {
+            uint64_t v = 0;
+            for (size_t i = 0; i < max_varint_size && offset + i < data.size(); ++i)
+            {
+                const uint8_t byte = data[offset + i];
+
+                // the 10th byte only has room for bit 63, anything more (or a continuation) is malformed.
+                if (i == max_varint_size - 1 && byte > 1) return false;
+
+                v |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+                if ((byte & 0x80) == 0)
+                {
+                    out = v;
+                    offset += i + 1;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// @brief integer to the unsigned value that goes over the wire (zigzag for signed types).
+        template<typename T>
+        BANKER_NODISCARD constexpr uint64_t to_wire(const T v)
+        {
+            if BANKER_CONSTEXPR (std::is_signed_v<T>) return zigzag_encode(static_cast<int64_t>(v));
+            else return static_cast<uint64_t>(v);
+        }
+
+        template<typename T>
+        BANKER_NODISCARD constexpr T from_wire(const uint64_t v)
+        {
+            if BANKER_CONSTEXPR (std::is_signed_v<T>) return static_cast<T>(zigzag_decode(v));
+            else return static_cast<T>(v);
+        }
+    }
+
+    /// @brief an integer written as a varint (zigzag for signed types) instead of sizeof(T) bytes.
+    /// @details converts to and from T, so it can be used as a BANKER_FIELDS field:
+    /// @code{.cpp}
+    /// struct tick { varint<uint32_t> instrument; varint<int64_t> change; BANKER_FIELDS(instrument, change) };
+    /// @endcode
+    template<typename T>
+    struct varint
+    {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "varint needs an integer of at most 64 bits");
+
+        T value{};
+
+        constexpr varint() = default;
+        constexpr varint(const T v) : value(v) {}
+
+        constexpr operator T() const { return value; }
+    };
+
+    /// @brief integers written as varint differences to the one before, for ids / timestamps that
+    /// only go up a little each time.
+    /// @details count (varint) followed by zigzag varints of value[i] - value[i - 1] (value[-1] = 0).
+    template<typename T>
+    struct delta_sequence
+    {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "delta_sequence needs integers of at most 64 bits");
+
+        std::vector<T> values{};
+
+        delta_sequence() = default;
+        delta_sequence(std::vector<T> v) : values(std::move(v)) {}
+
+        /// @brief bytes this takes on the wire.
+        BANKER_NODISCARD size_t encoded_size() const
+        {
+            size_t size = encoding::varint_size(values.size());
+            T previous{};
+            for (const T v : values)
+            {
+                size += encoding::varint_size(_delta(previous, v));
+                previous = v;
+            }
+            return size;
+        }
+
+        /// @brief writes the encoded values to 'out' (needs encoded_size() bytes).
+        /// @return bytes written.
+        size_t encode(uint8_t* out) const
+        {
+            size_t size = encoding::encode_varint(values.size(), out);
+            T previous{};
+            for (const T v : values)
+            {
+                size += encoding::encode_varint(_delta(previous, v), out + size);
+                previous = v;
+            }
+            return size;
+        }
+
+        /// @brief reads the values back.
+        /// @return true -> succeeded, false -> failed (truncated).
+        bool decode(const std::span<const uint8_t> data, size_t& offset)
+        {
+            uint64_t count = 0;
+            if (!encoding::decode_varint(data, offset, count)) return false;
+
+            // every value takes at least a byte, keeps a bad count from allocating.
+            if (count > data.size() - offset) return false;
+
+            values.resize(static_cast<size_t>(count));
+            uint64_t previous = 0;
+            for (T& v : values)
+            {
+                uint64_t delta = 0;
+                if (!encoding::decode_varint(data, offset, delta)) return false;
+                previous += static_cast<uint64_t>(encoding::zigzag_decode(delta));
+                v = static_cast<T>(previous);
+            }
+            return true;
+        }
+
+    private:
+        /// @brief difference with wrap around, so any step (even backwards) round trips.
+        static uint64_t _delta(const T previous, const T current)
+        {
+            const uint64_t diff = static_cast<uint64_t>(current) - static_cast<uint64_t>(previous);
+            return encoding::zigzag_encode(static_cast<int64_t>(diff));
+        }
+    };
+
+    namespace fields
+    {
+        template<typename T>
+        struct is_custom_encoded<varint<T>> : std::true_type {};
+
+        template<typename T>
+        struct is_custom_encoded<delta_sequence<T>> : std::true_type {};
+    }
+}
+
+#endif //BANKER_PACKET_ENCODINGS_HPP
@@ -0,0 +1,160 @@
+/* ================================== *\
+ @file     packet_fields.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_PACKET_FIELDS_HPP
+#define BANKER_PACKET_FIELDS_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "banker/shared/compat.hpp"
+
+/// @brief lists the fields of a struct so packet can write() / read() it as a whole.
+/// @details the fields go over the wire in the listed order, exactly as if written one by one.
+/// for aggregates it is checked at compile time that every field is listed.
+/// @code{.cpp}
+/// struct order
+/// {
+///     uint64_t id;
+///     double price;
+///     std::string account;
+///
+///     BANKER_FIELDS(id, price, account)
+/// };
+/// @endcode
+#define BANKER_FIELDS(...)                                                  \
+    auto banker_fields()        { return std::tie(__VA_ARGS__); }           \
+    auto banker_fields() const  { return std::tie(__VA_ARGS__); }
+
+namespace banker::networker::fields
+{
+    template<typename T, typename = void>
+    struct has_fields : std::false_type {};
+
+    template<typename T>
+    struct has_fields<T, std::void_t<decltype(std::declval<const T&>().banker_fields())>> : std::true_type {};
+
+    /// @brief if T used BANKER_FIELDS.
+    template<typename T>
+    constexpr bool has_fields_v = has_fields<T>::value;
+
+    /// @brief types with their own wire format (varint, delta_sequence ...), never copied as raw bytes.
+    template<typename T>
+    struct is_custom_encoded : std::false_type {};
+
+    /// @brief if T goes over the wire as its raw bytes (trivially copyable, no BANKER_FIELDS or own encoding).
+    template<typename T>
+    constexpr bool is_raw_v = std::is_trivially_copyable_v<T> && !has_fields_v<T> && !is_custom_encoded<T>::value;
+
+    template<typename T>
+    using tuple_of = decltype(std::declval<const T&>().banker_fields());
+
+    /// @brief amount of listed fields.
+    template<typename T>
+    constexpr size_t count = std::tuple_size_v<tuple_of<T>>;
+
+    /// @brief type of the I'th listed field.
+    template<typename T, size_t I>
+    using field_t = std::remove_cvref_t<std::tuple_element_t<I, tuple_of<T>>>;
+
+    /// @brief bytes T always takes on the wire, 0 if that depends on the value (strings, vectors ...).
+    template<typename T>
+    constexpr size_t fixed_size()
+    {
+        if BANKER_CONSTEXPR (has_fields_v<T>)
+        {
+            return []<size_t... I>(std::index_sequence<I...>)
+            {
+                const size_t sizes[] = {size_t{0}, fixed_size<field_t<T, I>>()...};
+                size_t total = 0;
+                for (size_t i = 1; i < std::size(sizes); ++i)
+                {
+                    if (sizes[i] == 0) return size_t{0};
+                    total += sizes[i];
+                }
+                return total;
+            }(std::make_index_sequence<count<T>>{});
+        }
+        else if BANKER_CONSTEXPR (is_raw_v<T>)
+        {
+            return sizeof(T);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    /// @brief amount of leading fields with a fixed size, these are read with a single bounds check.
+    template<typename T>
+    constexpr size_t fixed_prefix_count()
+    {
+        return []<size_t... I>(std::index_sequence<I...>)
+        {
+            const size_t sizes[] = {size_t{0}, fixed_size<field_t<T, I>>()...};
+            size_t n = 0;
+            while (n + 1 < std::size(sizes) && sizes[n + 1] != 0) ++n;
+            return n;
+        }(std::make_index_sequence<count<T>>{});
+    }
+
+    /// @brief bytes of the leading fixed size fields.
+    template<typename T>
+    constexpr size_t fixed_prefix_size()
+    {
+        return []<size_t... I>(std::index_sequence<I...>)
+        {
+            return (size_t{0} + ... + (I < fixed_prefix_count<T>() ? fixed_size<field_t<T, I>>() : 0));
+        }(std::make_index_sequence<count<T>>{});
+    }
+
+    /// @brief converts to anything, used to count the fields of an aggregate.
+    struct any_field
+    {
+        template<typename U>
+        operator U() const;
+    };
+
+    /// @brief amount of fields of an aggregate, found by brace initializing it with more and more values.
+    /// @note brace elision counts a C array member once per element, check() refuses those.
+    template<typename T, typename... Args>
+    constexpr size_t aggregate_field_count()
+    {
+        if BANKER_CONSTEXPR (requires { T{std::declval<Args>()..., std::declval<any_field>()}; })
+            return aggregate_field_count<T, Args..., any_field>();
+        else
+            return sizeof...(Args);
+    }
+
+    /// @brief if any listed field is a C array.
+    template<typename T>
+    constexpr bool has_array_field()
+    {
+        return []<size_t... I>(std::index_sequence<I...>)
+        {
+            return (false || ... || std::is_array_v<field_t<T, I>>);
+        }(std::make_index_sequence<count<T>>{});
+    }
+
+    /// @brief fails to compile when an aggregate has fields that BANKER_FIELDS doesn't list,
+    /// or lists a C array (it can't be read back by value, use std::array).
+    template<typename T>
+    constexpr void check()
+    {
+        static_assert(!has_array_field<T>(), "BANKER_FIELDS can't list C arrays, use std::array");
+
+        if BANKER_CONSTEXPR (std::is_aggregate_v<T>)
+        {
+            static_assert(aggregate_field_count<T>() == count<T>,
+                          "BANKER_FIELDS must list every field of the struct");
+        }
+    }
+}
+
+#endif //BANKER_PACKET_FIELDS_HPP
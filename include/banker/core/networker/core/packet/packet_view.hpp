@@ -0,0 +1,323 @@
+/* ================================== *\
+ @file     packet_view.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_PACKET_VIEW_HPP
+#define BANKER_PACKET_VIEW_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "banker/core/networker/core/packet/packet_encodings.hpp"
+#include "banker/core/networker/core/packet/packet_fields.hpp"
+#include "banker/shared/compat.hpp"
+#include "banker/shared/program_macros.hpp"
+
+namespace banker::networker
+{
+    /// @brief non owning, read only packet, same read() as packet.
+    /// @details points into someone else's bytes (usually a receive buffer), so it is only valid
+    /// as long as those bytes aren't touched. on top of what packet reads it can read
+    /// std::string_view, std::span<const uint8_t> and nested packet_views without copying.
+    class packet_view
+    {
+    public:
+        packet_view()   = default;
+        ~packet_view()  = default;
+
+        packet_view(const packet_view&)             = default;
+        packet_view& operator=(const packet_view&)  = default;
+
+        explicit packet_view(const std::span<const uint8_t> data, const size_t read_offset = 0)
+            : _data(data), _read_offset(read_offset) {}
+
+        /// @brief tries to read the value of T, same rules as packet::read().
+        /// @tparam T any trivially copyable, std::string, std::string_view, std::vector,
+        /// std::span<const uint8_t>, packet_view, varint, delta_sequence or struct with BANKER_FIELDS.
+        /// (can be combined: std::vector<std::string>)
+        /// @param valid set to 'false' if the read failed, if nullptr a failed read terminates.
+        /// @return the value it has read.
+        template<typename T>
+        T read(bool* valid = nullptr)
+        {
+            BANKER_SAFE(valid) = true;
+
+            bool ok = true;
+            T value = _read<T>(ok);
+            if (!ok)
+            {
+                if (valid == nullptr) { BANKER_TERMINATE("BAD PACKET (UNDERFLOW)"); }
+                *valid = false;
+            }
+            return value;
+        }
+
+        /// @brief all bytes of the packet.
+        BANKER_NODISCARD std::span<const uint8_t> get_data() const { return _data; }
+
+        /// @brief the bytes that haven't been read yet.
+        BANKER_NODISCARD std::span<const uint8_t> get_remaining_data() const
+        {
+            return _data.subspan(_read_offset);
+        }
+
+        /// @brief how far read() got.
+        BANKER_NODISCARD size_t read_offset() const { return _read_offset; }
+
+        BANKER_NODISCARD bool is_valid() const { return !_data.empty(); }
+
+    private:
+        std::span<const uint8_t> _data{};
+        size_t _read_offset{0};
+
+        template<typename T>
+        struct is_vector : std::false_type {};
+
+        template<typename T, typename Alloc>
+        struct is_vector<std::vector<T, Alloc>> : std::true_type {};
+
+        template<typename T>
+        struct is_varint : std::false_type {};
+
+        template<typename T>
+        struct is_varint<varint<T>> : std::true_type {};
+
+        template<typename T>
+        struct is_delta_sequence : std::false_type {};
+
+        template<typename T>
+        struct is_delta_sequence<delta_sequence<T>> : std::true_type {};
+
+        BANKER_NODISCARD bool _can_read(const size_t size) const
+        {
+            return size <= _data.size() - _read_offset;
+        }
+
+        /// @brief takes 'size' bytes, or an empty span (and ok = false) when there aren't enough.
+        std::span<const uint8_t> _take(const size_t size, bool& ok)
+        {
+            if (!_can_read(size))
+            {
+                ok = false;
+                return {};
+            }
+            const auto bytes = _data.subspan(_read_offset, size);
+            _read_offset += size;
+            return bytes;
+        }
+
+        template<typename T>
+        T _read(bool& ok)
+        {
+            if BANKER_CONSTEXPR (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+            {
+                const auto len = _read<uint32_t>(ok);
+                const auto bytes = _take(len, ok);
+                if (!ok) return {};
+                return T(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            }
+            else if BANKER_CONSTEXPR (std::is_same_v<T, std::span<const uint8_t>>)
+            {
+                const auto len = _read<uint32_t>(ok);
+                return _take(len, ok);
+            }
+            else if BANKER_CONSTEXPR (std::is_same_v<T, packet_view>)
+            {
+                const auto len = _read<uint32_t>(ok);
+                return packet_view(_take(len, ok));
+            }
+            else if BANKER_CONSTEXPR (is_vector<T>::value)
+            {
+                using elem_t = typename T::value_type;
+
+                const auto len = _read<uint32_t>(ok);
+                if (!ok || !_can_read(len)) { ok = false; return {}; }
+
+                if BANKER_CONSTEXPR (fields::is_raw_v<elem_t> && !std::is_same_v<elem_t, bool>)
+                {
+                    // same bytes as element by element, in one copy.
+                    const auto bytes = _take(static_cast<size_t>(len) * sizeof(elem_t), ok);
+                    if (!ok) return {};
+
+                    T vec(len);
+                    std::memcpy(vec.data(), bytes.data(), bytes.size());
+                    return vec;
+                }
+                else
+                {
+                    T vec(len);
+                    for (uint32_t i = 0; i < len && ok; ++i)
+                        vec[i] = _read<elem_t>(ok);
+
+                    return vec;
+                }
+            }
+            else if BANKER_CONSTEXPR (is_varint<T>::value)
+            {
+                uint64_t wire = 0;
+                if (!encoding::decode_varint(_data, _read_offset, wire)) { ok = false; return {}; }
+
+                using value_t = decltype(T::value);
+                const auto value = encoding::from_wire<value_t>(wire);
+                if (encoding::to_wire(value) != wire) { ok = false; return {}; }    // didn't fit in T.
+                return T{value};
+            }
+            else if BANKER_CONSTEXPR (is_delta_sequence<T>::value)
+            {
+                T sequence{};
+                if (!sequence.decode(_data, _read_offset)) ok = false;
+                return sequence;
+            }
+            else if BANKER_CONSTEXPR (fields::has_fields_v<T>)
+            {
+                fields::check<T>();
+
+                // one bounds check covers all leading fixed size fields.
+                T value{};
+                if (!_can_read(fields::fixed_prefix_size<T>())) { ok = false; return value; }
+
+                auto tied = value.banker_fields();
+                [&]<size_t... I>(std::index_sequence<I...>)
+                {
+                    (_read_field<(I >= fields::fixed_prefix_count<T>())>(std::get<I>(tied), ok), ...);
+                }(std::make_index_sequence<fields::count<T>>{});
+
+                return value;
+            }
+            else
+            {
+                static_assert(std::is_trivially_copyable_v<T>,
+                              "T must be trivially copyable, std::string, std::vector or use BANKER_FIELDS");
+
+                T value{};
+                const auto bytes = _take(sizeof(T), ok);
+                if (ok) std::memcpy(&value, bytes.data(), sizeof(T));
+                return value;
+            }
+        }
+
+        template<bool Checked, typename F>
+        void _read_field(F& out, bool& ok)
+        {
+            if (!ok) return;
+            if BANKER_CONSTEXPR (Checked) out = _read<F>(ok);
+            else _read_fixed(out);
+        }
+
+        /// @brief reads a fixed size value without a bounds check, the caller checked already.
+        template<typename F>
+        void _read_fixed(F& out)
+        {
+            if BANKER_CONSTEXPR (fields::has_fields_v<F>)
+            {
+                std::apply([this](auto&... field) { (_read_fixed(field), ...); }, out.banker_fields());
+            }
+            else
+            {
+                std::memcpy(&out, _data.data() + _read_offset, sizeof(F));
+                _read_offset += sizeof(F);
+            }
+        }
+    };
+
+    /// @brief walks the complete length prefixed frames (see packet::serialize_to_stream()) of a stream.
+    /// @details nothing is copied or moved, every frame is a packet_view into the stream.
+    /// once done, drop consumed() bytes from the stream in one go:
+    /// @code{.cpp}
+    /// auto bytes = client.receive().contiguous();
+    /// frame_reader frames{bytes};
+    /// for (packet_view frame : frames) handle(frame);
+    /// client.receive().consume(frames.consumed());
+    /// @endcode
+    class frame_reader
+    {
+    public:
+        /// @brief size of the length prefix in front of every frame.
+        static constexpr size_t header_size = sizeof(uint32_t);
+
+        class iterator
+        {
+        public:
+            using value_type        = packet_view;
+            using difference_type   = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(frame_reader* reader) : _reader(reader) { _advance(); }
+
+            const packet_view& operator*() const { return _current; }
+            const packet_view* operator->() const { return &_current; }
+
+            iterator& operator++()
+            {
+                _advance();
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const { return _reader == other._reader; }
+            bool operator!=(const iterator& other) const { return _reader != other._reader; }
+
+        private:
+            frame_reader* _reader{nullptr};
+            packet_view _current{};
+
+            void _advance()
+            {
+                if (_reader != nullptr && !_reader->next(_current)) _reader = nullptr;
+            }
+        };
+
+    public:
+        explicit frame_reader(const std::span<const uint8_t> stream)
+            : _stream(stream) {}
+
+        /// @brief reads the next complete frame.
+        /// @param frame set to the frame's payload.
+        /// @return true -> got a frame, false -> no complete frame left (or an empty frame, which is invalid).
+        bool next(packet_view& frame)
+        {
+            const size_t available = _stream.size() - _consumed;
+            if (available < header_size) return false;
+
+            const uint8_t* h = _stream.data() + _consumed;
+            const size_t size =
+                (static_cast<size_t>(h[0]) << 24) |
+                (static_cast<size_t>(h[1]) << 16) |
+                (static_cast<size_t>(h[2]) << 8)  |
+                 static_cast<size_t>(h[3]);
+
+            if (size == 0 || available - header_size < size) return false;
+
+            frame = packet_view(_stream.subspan(_consumed + header_size, size));
+            _consumed += header_size + size;
+            return true;
+        }
+
+        /// @brief bytes taken by the frames read so far, drop these from the stream when done.
+        BANKER_NODISCARD size_t consumed() const { return _consumed; }
+
+        iterator begin() { return iterator{this}; }
+        iterator end() { return iterator{}; }
+
+        /// @brief removes the read frames from the front of a vector stream with a single erase.
+        template<typename Allocator>
+        void compact(std::vector<uint8_t, Allocator>& stream) const
+        {
+            stream.erase(stream.begin(), stream.begin() + static_cast<std::ptrdiff_t>(_consumed));
+        }
+
+    private:
+        std::span<const uint8_t> _stream{};
+        size_t _consumed{0};
+    };
+}
+
+#endif //BANKER_PACKET_VIEW_HPP
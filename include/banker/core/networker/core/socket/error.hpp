@@ -27,6 +27,7 @@ namespace banker::networker
         host_unreachable,   // host/network unreachable
         net_down,           // network down
         addr_in_use,        // address already in use (bind() failure)
+        no_resources,       // out of file descriptors or buffer space (accept() failure)
         interrupted,        // system call interrupted
         unknown             // unknown/error
     };
@@ -46,6 +47,8 @@ namespace banker::networker
             case WSAEHOSTUNREACH:   return socket_error_code::host_unreachable;
             case WSAENETDOWN:       return socket_error_code::net_down;
             case WSAEADDRINUSE:     return socket_error_code::addr_in_use;
+            case WSAEMFILE:
+            case WSAENOBUFS:        return socket_error_code::no_resources;
             case WSAEINTR:          return socket_error_code::interrupted;
             default:                return socket_error_code::unknown;
         }
@@ -54,7 +57,7 @@ namespace banker::networker
             {
             case 0:                 return socket_error_code::none;
             case EWOULDBLOCK:
-#ifdef EAGAIN
+#if defined(EAGAIN) && EAGAIN != EWOULDBLOCK
             case EAGAIN:
 #endif
                                     return socket_error_code::would_block;
@@ -64,6 +67,10 @@ namespace banker::networker
             case EHOSTUNREACH:      return socket_error_code::host_unreachable;
             case ENETDOWN:          return socket_error_code::net_down;
             case EADDRINUSE:        return socket_error_code::addr_in_use;
+            case EMFILE:
+            case ENFILE:
+            case ENOBUFS:
+            case ENOMEM:            return socket_error_code::no_resources;
             case EINTR:             return socket_error_code::interrupted;
             default:                return socket_error_code::unknown;
         }
@@ -85,6 +92,7 @@ namespace banker::networker
             case socket_error_code::host_unreachable:return "host_unreachable";
             case socket_error_code::net_down:        return "net_down";
             case socket_error_code::addr_in_use:     return "addr_in_use";
+            case socket_error_code::no_resources:    return "no_resources";
             case socket_error_code::interrupted:     return "interrupted";
             case socket_error_code::unknown:         return "unknown";
         }
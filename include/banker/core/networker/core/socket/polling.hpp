@@ -12,59 +12,249 @@
 #include <span>
 #include <chrono>
 #include <algorithm>
+#include <cstdint>
 
 #include "banker/common/debugging/debugger.hpp"
 #include "banker/core/networker/core/socket/socket.hpp"
 #include "banker/shared/program_macros.hpp"
 
+#ifndef _WIN32
+    #include <sys/epoll.h>      // epoll_create1(), epoll_ctl(), epoll_wait()
+#endif
+
 namespace banker::networker
 {
     class poll_group
     {
     public:
+        /// @brief which readiness events a registration cares about.
+        enum class interest : uint8_t
+        {
+            read    = 1 << 0,
+            write   = 1 << 1,
+            both    = read | write,
+        };
+
+        /// @brief how readiness is reported.
+        /// @note windows (WSAPoll) only supports level triggering, edge is treated as level there.
+        enum class trigger : uint8_t
+        {
+            /// @brief reported every poll for as long as the socket is ready.
+            level,
+
+            /// @brief reported once per readiness change, the socket must be drained until would_block.
+            edge,
+        };
+
         struct result
         {
             bool readable       {false};
             bool writable       {false};
             bool error          {false};
             bool disconnected   {false};
+
+            /// @brief the fd that is ready.
+            socket_t fd         {socket::invalid_socket};
+
+            /// @brief the value given to add() / modify() for this fd.
+            uint64_t user_data  {0};
         };
 
     public:
+        /// @brief poll_group ctor.
+        /// @param mode trigger mode used for every registration in this group.
+        explicit poll_group(const trigger mode = trigger::level)
+            : _trigger(mode)
+        {
+#ifndef _WIN32
+            _epoll = epoll_create1(EPOLL_CLOEXEC);
+            _events.resize(_default_event_capacity);
+#endif
+        }
+
+        ~poll_group()
+        {
+#ifndef _WIN32
+            if (_epoll != -1) ::close(_epoll);
+#endif
+        }
+
+        poll_group(const poll_group&)               = delete;
+        poll_group& operator=(const poll_group&)    = delete;
+
+        poll_group(poll_group&& other) noexcept
+        {
+            *this = std::move(other);
+        }
+
+        poll_group& operator=(poll_group&& other) noexcept
+        {
+            if (this == &other) return *this;
+#ifndef _WIN32
+            if (_epoll != -1) ::close(_epoll);
+            _epoll = other._epoll;
+            other._epoll = -1;
+            _events = std::move(other._events);
+            _ready_count = other._ready_count;
+#else
+            _fds = std::move(other._fds);
+#endif
+            _user_data = std::move(other._user_data);
+            _read_offset = other._read_offset;
+            _trigger = other._trigger;
+            return *this;
+        }
+
+        /// @brief if the group could create its OS resources.
+        BANKER_NODISCARD bool is_valid() const
+        {
+#ifdef _WIN32
+            return true;
+#else
+            return _epoll != -1;
+#endif
+        }
+
+        /// @brief reserves space for 'size' registrations.
+        /// @param size amount of sockets expected.
         void reserve(const size_t size)
         {
 #ifdef _WIN32
             _fds.reserve(size);
+            _user_data.reserve(size);
+#else
+            if (_events.size() < size) _events.resize(size);
 #endif
         }
 
-        void add(const socket& socket)
+        /// @brief registers a socket.
+        /// @param socket a valid socket, must outlive its registration.
+        /// @param interests which events to report.
+        /// @param user_data returned with every result for this socket.
+        /// @return true -> succeeded, false -> failed (already added or OS error).
+        bool add(
+            const socket& socket,
+            const interest interests = interest::both,
+            const uint64_t user_data = 0)
         {
+            if (!socket.is_valid()) return false;
 #ifdef _WIN32
-            _fds.emplace_back(
+            if (_find(socket.to_fd()) != _fds.size()) return false;
+            _fds.push_back(WSAPOLLFD{
                 socket.to_fd(),
-                POLLRDNORM | POLLWRNORM,
-                0);
+                _to_native(interests),
+                0});
+            _user_data.push_back(user_data);
+            return true;
+#else
+            epoll_event ev = _make_event(socket.to_fd(), interests);
+            if (epoll_ctl(_epoll, EPOLL_CTL_ADD, socket.to_fd(), &ev) != 0)
+            {
+                BANKER_DEBUG_DO(banker::debug::log("epoll_ctl(ADD) ERROR: ", errno, "\n"));
+                return false;
+            }
+            _set_user_data(socket.to_fd(), user_data);
+            return true;
 #endif
         }
 
-        void reset()
+        /// @brief changes the interests and user data of an already added socket.
+        /// @param socket a socket that was added before.
+        /// @param interests which events to report from now on.
+        /// @param user_data returned with every result for this socket.
+        /// @return true -> succeeded, false -> failed (not added or OS error).
+        bool modify(
+            const socket& socket,
+            const interest interests,
+            const uint64_t user_data)
+        {
+#ifdef _WIN32
+            const size_t index = _find(socket.to_fd());
+            if (index == _fds.size()) return false;
+            _fds[index].events = _to_native(interests);
+            _user_data[index] = user_data;
+            return true;
+#else
+            epoll_event ev = _make_event(socket.to_fd(), interests);
+            if (epoll_ctl(_epoll, EPOLL_CTL_MOD, socket.to_fd(), &ev) != 0)
+                return false;
+            _set_user_data(socket.to_fd(), user_data);
+            return true;
+#endif
+        }
+
+        /// @brief changes the interests of an already added socket, keeping its user data.
+        /// @return true -> succeeded, false -> failed (not added or OS error).
+        bool modify(
+            const socket& socket,
+            const interest interests)
+        {
+            return modify(socket, interests, user_data_of(socket));
+        }
+
+        /// @brief unregisters a socket, should be called before the socket gets closed.
+        /// @param socket a socket that was added before.
+        /// @return true -> succeeded, false -> it wasn't added.
+        bool remove(const socket& socket)
+        {
+#ifdef _WIN32
+            const size_t index = _find(socket.to_fd());
+            if (index == _fds.size()) return false;
+            _fds[index] = _fds.back();
+            _fds.pop_back();
+            _user_data[index] = _user_data.back();
+            _user_data.pop_back();
+            return true;
+#else
+            // kernels before 2.6.9 require a non null event even for DEL.
+            epoll_event ev{};
+            if (epoll_ctl(_epoll, EPOLL_CTL_DEL, socket.to_fd(), &ev) != 0) return false;
+
+            // the fd number gets reused, don't hand its user data to the next socket.
+            const auto fd = static_cast<size_t>(socket.to_fd());
+            if (fd < _user_data.size()) _user_data[fd] = 0;
+            return true;
+#endif
+        }
+
+        /// @brief the user data of a registered socket (0 if unknown).
+        BANKER_NODISCARD uint64_t user_data_of(const socket& socket) const
         {
 #ifdef _WIN32
+            const size_t index = _find(socket.to_fd());
+            return index == _fds.size() ? 0 : _user_data[index];
+#else
+            const auto fd = static_cast<size_t>(socket.to_fd());
+            return fd < _user_data.size() ? _user_data[fd] : 0;
+#endif
+        }
+
+        /// @brief removes every registration.
+        void reset()
+        {
             _read_offset = 0;
+            _user_data.clear();
+#ifdef _WIN32
             _fds.clear();
+#else
+            _ready_count = 0;
+            if (_epoll != -1) ::close(_epoll);
+            _epoll = epoll_create1(EPOLL_CLOEXEC);
 #endif
         }
 
-        void poll(const int timeout = 0)
+        /// @brief waits for readiness on the registered sockets, results are read with next_result().
+        /// @param timeout in ms, 0 returns immediately, -1 waits forever.
+        /// @return amount of ready sockets, or -1 on error.
+        int poll(const int timeout = 0)
         {
-#ifdef _WIN32
             _read_offset = 0;
+#ifdef _WIN32
             BANKER_DEBUG_DO(
                 if (_fds.empty())
                 {
                     banker::debug::log("_fds.empty()");
-                    return;
+                    return 0;
                 }
             );
 
@@ -96,38 +286,136 @@ namespace banker::networker
                     banker::debug::log("WSAPoll ERROR: " , error , "\n");
                 }
             );
+
+            return result == SOCKET_ERROR ? -1 : result;
+#else
+            _ready_count = 0;
+
+            const int ready = epoll_wait(
+                _epoll,
+                _events.data(),
+                static_cast<int>(_events.size()),
+                timeout);
+
+            if (ready < 0)
+            {
+                // a signal isn't an error, just nothing ready.
+                if (errno == EINTR) return 0;
+
+                BANKER_DEBUG_DO(banker::debug::log("epoll_wait ERROR: ", errno, "\n"));
+                return -1;
+            }
+
+            _ready_count = static_cast<size_t>(ready);
+
+            // every slot got filled, there might be more ready so grow for the next poll.
+            if (_ready_count == _events.size())
+                _events.resize(_events.size() * 2);
+
+            return ready;
 #endif
         }
 
-        /// @brief
-        /// @param result
-        /// @return index of socket or -1 if end of socket
+        /// @brief reads the next ready socket from the last poll().
+        /// @param result filled with the readiness of the socket.
+        /// @return index of the result (in ready order) or -1 if there are no more results.
         int next_result(
             result& result)
         {
 #ifdef _WIN32
+            // skip the sockets that had nothing happen.
+            while (_read_offset < _fds.size() && _fds[_read_offset].revents == 0)
+                ++_read_offset;
+
             if (_read_offset >= _fds.size()) return -1;
 
+            const auto& fd = _fds[_read_offset];
+            result =
+            {
+                (fd.revents & POLLIN) != 0,
+                (fd.revents & POLLOUT) != 0,
+                (fd.revents & POLLERR) != 0,
+                (fd.revents & POLLHUP) != 0,
+                fd.fd,
+                _user_data[_read_offset],
+            };
+
+            return static_cast<int>(_read_offset++);
+#else
+            if (_read_offset >= _ready_count) return -1;
+
+            const epoll_event& ev = _events[_read_offset];
+            const auto fd = static_cast<socket_t>(ev.data.fd);
             result =
             {
-                (_fds[_read_offset].revents & POLLIN) != 0,
-                (_fds[_read_offset].revents & POLLOUT) != 0,
-                (_fds[_read_offset].revents & POLLERR) != 0,
-                (_fds[_read_offset].revents & POLLHUP) != 0,
+                (ev.events & EPOLLIN) != 0,
+                (ev.events & EPOLLOUT) != 0,
+                (ev.events & EPOLLERR) != 0,
+                (ev.events & (EPOLLHUP | EPOLLRDHUP)) != 0,
+                fd,
+                static_cast<size_t>(fd) < _user_data.size() ? _user_data[static_cast<size_t>(fd)] : 0,
             };
 
-            return _read_offset++;
+            return static_cast<int>(_read_offset++);
 #endif
         }
 
     private:
+        trigger _trigger{trigger::level};
+        size_t _read_offset{0};
+
 #ifdef _WIN32
         std::vector<WSAPOLLFD> _fds{};
-        uint16_t _read_offset{0};
+
+        /// @brief parallel to _fds.
+        std::vector<uint64_t> _user_data{};
+
+        BANKER_NODISCARD size_t _find(const socket_t fd) const
+        {
+            for (size_t i = 0; i < _fds.size(); ++i)
+                if (_fds[i].fd == fd) return i;
+            return _fds.size();
+        }
+
+        static SHORT _to_native(const interest interests)
+        {
+            SHORT events = 0;
+            if (static_cast<uint8_t>(interests) & static_cast<uint8_t>(interest::read))  events |= POLLRDNORM;
+            if (static_cast<uint8_t>(interests) & static_cast<uint8_t>(interest::write)) events |= POLLWRNORM;
+            return events;
+        }
 #else
+        static constexpr size_t _default_event_capacity = 64;
+
+        int _epoll{-1};
+        std::vector<epoll_event> _events{};
+        size_t _ready_count{0};
+
+        /// @brief indexed by fd, fds are small and dense so this beats a map.
+        std::vector<uint64_t> _user_data{};
+
+        void _set_user_data(const socket_t fd, const uint64_t user_data)
+        {
+            const auto index = static_cast<size_t>(fd);
+            if (index >= _user_data.size()) _user_data.resize(index + 1, 0);
+            _user_data[index] = user_data;
+        }
+
+        BANKER_NODISCARD epoll_event _make_event(
+            const socket_t fd,
+            const interest interests) const
+        {
+            epoll_event ev{};
+            ev.data.fd = fd;
+            ev.events = EPOLLRDHUP;
+            if (static_cast<uint8_t>(interests) & static_cast<uint8_t>(interest::read))  ev.events |= EPOLLIN;
+            if (static_cast<uint8_t>(interests) & static_cast<uint8_t>(interest::write)) ev.events |= EPOLLOUT;
+            if (_trigger == trigger::edge) ev.events |= EPOLLET;
+            return ev;
+        }
 #endif
     };
 }
 
 
-#endif //BANKER_POLLING_HPP
\ No newline at end of file
+#endif //BANKER_POLLING_HPP
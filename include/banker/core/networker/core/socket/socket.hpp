@@ -8,8 +8,10 @@
 #ifndef BANKER_SOCKET_HPP
 #define BANKER_SOCKET_HPP
 
+#include <algorithm>
 #include <numeric>
 #include <span>
+#include <vector>
 
 #include "error.hpp"
 #include "banker/debug_inspector.hpp"
@@ -31,6 +33,7 @@
     #include <sys/time.h>       // timeval
     #include <sys/types.h>      // socklen_t fd_set
     #include <sys/uio.h>        // for writev
+    #include <climits>          // IOV_MAX
     typedef int socket_t;
     constexpr socket_t BANKER_INVALID_SOCKET = ( -1 );
     constexpr int BANKER_SOCKET_ERROR = ( -1 );
@@ -88,7 +91,7 @@ namespace banker::networker
         {
             std::string ip_address{};
             uint16_t port{0};
-            domain domain{domain::invalid};
+            socket::domain domain{socket::domain::invalid};
 
             /// @brief turns any connection_info state into a string.
             /// @return string.
@@ -126,6 +129,34 @@ namespace banker::networker
             size_t len;
         };
 
+#ifdef _WIN32
+        /// @brief the OS scatter / gather element, handed to the OS as is by sendv_native.
+        using native_iovec = WSABUF;
+
+        /// @brief most buffers a single sendv_native call will take.
+        static constexpr size_t max_iovecs = 1024;
+#else
+        /// @brief the OS scatter / gather element, handed to the OS as is by sendv_native.
+        using native_iovec = struct iovec;
+
+        /// @brief most buffers a single sendv_native call will take.
+        static constexpr size_t max_iovecs = IOV_MAX;
+#endif
+
+        /// @brief makes a native_iovec.
+        static native_iovec make_native_iovec(const void* data, const size_t len)
+        {
+            native_iovec v{};
+#ifdef _WIN32
+            v.buf = const_cast<CHAR*>(static_cast<const CHAR*>(data));
+            v.len = static_cast<ULONG>(len);
+#else
+            v.iov_base = const_cast<void*>(data);
+            v.iov_len  = len;
+#endif
+            return v;
+        }
+
     public:
         /// @brief if the socket is valid.
         /// @return true -> valid, false -> invalid.
@@ -180,6 +211,8 @@ namespace banker::networker
         {
             if (this != &other)
             {
+                // the socket that gets replaced is owned, so it has to be released first.
+                if (is_valid()) (void)close();
                 _socket = other._socket;
                 _domain = other._domain;
                 other._socket = invalid_socket;
@@ -357,7 +390,7 @@ namespace banker::networker
 
             for (size_t i = 0; i < count; ++i)
             {
-                buf_ptr[i].iov_base = buffers[i].data;
+                buf_ptr[i].iov_base = const_cast<void*>(buffers[i].data);
                 buf_ptr[i].iov_len  = buffers[i].len;
             }
 
@@ -366,6 +399,31 @@ namespace banker::networker
 #endif
         }
 
+        /// @brief sends multiple buffers in order to the host, without converting them first.
+        /// @param buffers contiguous native buffers.
+        /// @param count count of valid buffers, anything above max_iovecs is left for the next call.
+        /// @return the number of bytes actually sent, or a negative value if an error occurred.
+        [[nodiscard]] int sendv_native(
+            const native_iovec* buffers,
+            size_t count)
+        {
+            if (count == 0 || !buffers) return -1;
+            count = std::min(count, max_iovecs);
+#ifdef _WIN32
+            DWORD sent = 0;
+            const int res = WSASend(
+                _socket,
+                const_cast<native_iovec*>(buffers),
+                static_cast<DWORD>(count),
+                &sent, 0, nullptr, nullptr);
+            if (res != 0) return -1;
+            return static_cast<int>(sent);
+#else
+            const ssize_t n = ::writev(_socket, buffers, static_cast<int>(count));
+            return static_cast<int>(n);
+#endif
+        }
+
         /// @brief cleaner way of using sendv, can be used with brace initializer.
         /// @tparam N amount of elements
         /// @param buffers (buffer ptr, buffer size)
@@ -391,6 +449,44 @@ namespace banker::networker
             return n;
         }
 
+        /// @brief receives data into multiple buffers in order (scatter read).
+        /// @param buffers writable buffers, filled front to back.
+        /// @param count count of buffers (keep it small, meant for ring buffers that wrap).
+        /// @return the number of bytes actually received, 0 if the connection was closed,
+        ///         or a negative value if an error occurred. (same as recv)
+        [[nodiscard]] int recvv(
+            const std::span<uint8_t>* buffers,
+            const size_t count)
+        {
+            if (count == 0 || !buffers) return -1;
+#ifdef _WIN32
+            WSABUF bufs[4];
+            const size_t n_bufs = std::min(count, std::size(bufs));
+            for (size_t i = 0; i < n_bufs; ++i)
+            {
+                bufs[i].buf = reinterpret_cast<CHAR*>(buffers[i].data());
+                bufs[i].len = static_cast<ULONG>(buffers[i].size());
+            }
+
+            DWORD received = 0;
+            DWORD flags = 0;
+            const int res = WSARecv(_socket, bufs, static_cast<DWORD>(n_bufs), &received, &flags, nullptr, nullptr);
+            if (res != 0) return -1;
+            return static_cast<int>(received);
+#else
+            struct iovec bufs[4];
+            const size_t n_bufs = std::min(count, std::size(bufs));
+            for (size_t i = 0; i < n_bufs; ++i)
+            {
+                bufs[i].iov_base = buffers[i].data();
+                bufs[i].iov_len  = buffers[i].size();
+            }
+
+            const ssize_t n = ::readv(_socket, bufs, static_cast<int>(n_bufs));
+            return static_cast<int>(n);
+#endif
+        }
+
         /// @brief closes the socket and releases any system resources associated with it.
         /// @return the result of the underlying system call. (should almost never fail)
         ///       @code{.cpp}
@@ -432,6 +528,30 @@ namespace banker::networker
 #endif
         }
 
+        /// @brief if the platform can load balance one port over multiple listening sockets (SO_REUSEPORT).
+#if defined(_WIN32) || !defined(SO_REUSEPORT)
+        static constexpr bool supports_reuse_port = false;
+#else
+        static constexpr bool supports_reuse_port = true;
+#endif
+
+        /// @brief enables or disables the SO_REUSEPORT.
+        /// This allows multiple sockets to bind the exact same address/port,
+        ///     the kernel then spreads incoming connections over all of their listen queues.
+        /// @param enable which option to use.
+        /// @return true -> succeeded, false -> failed (always fails if !supports_reuse_port).
+        /// @note this function should be used right after socket creation, on every socket sharing the port.
+        [[nodiscard]] bool set_reuse_port(const bool enable = true)
+        {
+#if defined(_WIN32) || !defined(SO_REUSEPORT)
+            (void)enable;
+            return false;
+#else
+            int opt = enable ? 1 : 0;
+            return setsockopt(_socket, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) == 0;
+#endif
+        }
+
         [[nodiscard]] connection_info get_peer_info() const
         {
             if (!is_valid())
@@ -0,0 +1,180 @@
+/* ================================== *\
+ @file     stream_receive_buffer.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_STREAM_RECEIVE_BUFFER_HPP
+#define BANKER_STREAM_RECEIVE_BUFFER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+
+#include "banker/shared/compat.hpp"
+
+namespace banker::networker
+{
+    /// @brief growable byte ring for incoming stream data.
+    /// @details the OS reads straight into the free space (see prepare() / commit()),
+    /// and consumers advance with consume() which is O(1), nothing gets moved to the front.
+    /// data only gets moved when contiguous() is asked for a view that wraps around the end.
+    class stream_receive_buffer
+    {
+    public:
+        stream_receive_buffer()     = default;
+        ~stream_receive_buffer()    = default;
+
+        stream_receive_buffer(const stream_receive_buffer&)             = delete;
+        stream_receive_buffer& operator=(const stream_receive_buffer&)  = delete;
+
+        stream_receive_buffer(stream_receive_buffer&& other) noexcept
+            : _data(std::move(other._data)),
+              _capacity(other._capacity),
+              _head(other._head),
+              _size(other._size)
+        {
+            other._capacity = other._head = other._size = 0;
+        }
+
+        stream_receive_buffer& operator=(stream_receive_buffer&& other) noexcept
+        {
+            if (this == &other) return *this;
+            _data = std::move(other._data);
+            _capacity = other._capacity;
+            _head = other._head;
+            _size = other._size;
+            other._capacity = other._head = other._size = 0;
+            return *this;
+        }
+
+        /// @brief amount of readable bytes.
+        BANKER_NODISCARD size_t size() const { return _size; }
+
+        BANKER_NODISCARD bool empty() const { return _size == 0; }
+
+        BANKER_NODISCARD size_t capacity() const { return _capacity; }
+
+        /// @brief the readable bytes up to the end of the storage, never moves data.
+        /// @note can be shorter than size(), the rest starts at the front of the storage.
+        BANKER_NODISCARD std::span<uint8_t> front()
+        {
+            return { _data.get() + _head, std::min(_size, _capacity - _head) };
+        }
+
+        /// @brief all readable bytes as one view, moves data only when they wrap around.
+        BANKER_NODISCARD std::span<uint8_t> contiguous()
+        {
+            if (_head + _size > _capacity) _relocate(_capacity);
+            return { _data.get() + _head, _size };
+        }
+
+        /// @brief copies 'size' readable bytes starting at 'offset' into 'out' without consuming them.
+        /// @return false if there aren't enough readable bytes.
+        bool peek(void* out, const size_t size, const size_t offset = 0) const
+        {
+            if (offset + size > _size) return false;
+            if (size == 0) return true;
+
+            auto* dst = static_cast<uint8_t*>(out);
+            const size_t start = (_head + offset) & _mask();
+            const size_t first = std::min(size, _capacity - start);
+            std::memcpy(dst, _data.get() + start, first);
+            std::memcpy(dst + first, _data.get(), size - first);
+            return true;
+        }
+
+        /// @brief drops 'bytes' from the front, O(1).
+        void consume(size_t bytes)
+        {
+            bytes = std::min(bytes, _size);
+            _size -= bytes;
+            // restart at the front when drained, keeps the next reads contiguous.
+            _head = _size == 0 ? 0 : (_head + bytes) & _mask();
+        }
+
+        /// @brief drops all readable bytes.
+        void clear()
+        {
+            _head = 0;
+            _size = 0;
+        }
+
+        /// @brief makes sure at least 'min_free' bytes can be written and returns where.
+        /// @param min_free bytes that need to fit.
+        /// @param out filled with 1 or 2 spans of free space (2 when it wraps).
+        /// @return amount of spans filled.
+        size_t prepare(
+            const size_t min_free,
+            std::span<uint8_t> (&out)[2])
+        {
+            if (_capacity - _size < min_free) _grow(_size + min_free);
+
+            const size_t tail = (_head + _size) & _mask();
+            const size_t free = _capacity - _size;
+
+            if (tail >= _head || _size == 0)
+            {
+                const size_t first = std::min(free, _capacity - tail);
+                out[0] = { _data.get() + tail, first };
+                if (first == free) return 1;
+                out[1] = { _data.get(), free - first };
+                return 2;
+            }
+
+            out[0] = { _data.get() + tail, free };
+            return 1;
+        }
+
+        /// @brief marks 'bytes' of the prepared space as readable.
+        void commit(const size_t bytes)
+        {
+            BANKER_ASSERT(_size + bytes <= _capacity);
+            _size += bytes;
+        }
+
+        /// @brief copies bytes to the back.
+        void append(const uint8_t* data, const size_t size)
+        {
+            std::span<uint8_t> spans[2];
+            const size_t count = prepare(size, spans);
+
+            const size_t first = std::min(size, spans[0].size());
+            std::memcpy(spans[0].data(), data, first);
+            if (count > 1 && size > first) std::memcpy(spans[1].data(), data + first, size - first);
+            commit(size);
+        }
+
+    private:
+        static constexpr size_t _min_capacity = 1024 * 16;
+
+        std::unique_ptr<uint8_t[]> _data{};
+        size_t _capacity{0};
+        size_t _head{0};
+        size_t _size{0};
+
+        BANKER_NODISCARD size_t _mask() const { return _capacity - 1; }
+
+        void _grow(const size_t required)
+        {
+            size_t capacity = std::max(_capacity, _min_capacity);
+            while (capacity < required) capacity <<= 1;
+            _relocate(capacity);
+        }
+
+        /// @brief moves the readable bytes to the front of a (new) storage of 'capacity'.
+        void _relocate(const size_t capacity)
+        {
+            std::unique_ptr<uint8_t[]> data{new uint8_t[capacity]};
+            if (_size > 0) peek(data.get(), _size);
+            _data = std::move(data);
+            _capacity = capacity;
+            _head = 0;
+        }
+    };
+}
+
+#endif //BANKER_STREAM_RECEIVE_BUFFER_HPP
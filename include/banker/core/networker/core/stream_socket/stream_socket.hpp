@@ -10,7 +10,9 @@
 #include <cstdint>
 
 #include "stream_socket_core.hpp"
+#include "banker/core/networker/core/packet/packet_view.hpp"
 #include "banker/core/networker/core/socket/socket.hpp"
+#include "banker/core/networker/crypto/crypto_stream_core.hpp"
 #include "banker/shared/compat.hpp"
 
 namespace banker::networker
@@ -20,6 +22,9 @@ namespace banker::networker
     public:
         class acceptor;
 
+        using enqueue_result    = stream_socket_core::enqueue_result;
+        using send_limits       = stream_socket_core::send_limits;
+
     public:
         explicit stream_socket(socket&& socket)
         {
@@ -52,28 +57,142 @@ namespace banker::networker
             return _socket;
         }
 
-        BANKER_NODISCARD std::vector<uint8_t>& receive()
+        /// @brief received data, read it with contiguous() / front() and drop it with consume().
+        BANKER_NODISCARD stream_receive_buffer& receive()
         {
             return _receive_state.receive_buffer;
         }
 
-        void enqueue(const std::vector<uint8_t>& data)
+        /// @brief if there is queued data that hasn't been written yet.
+        BANKER_NODISCARD bool has_pending_send() const
+        {
+            return !_send_state.out_buffers.empty();
+        }
+
+        /// @brief sets the send queue limits (watermarks and overflow policy), see send_limits.
+        void set_send_limits(const send_limits& limits)
+        {
+            _send_state.limits = limits;
+        }
+
+        /// @brief bytes queued but not written yet.
+        BANKER_NODISCARD size_t queued_bytes() const
+        {
+            return _send_state.queued_bytes;
+        }
+
+        /// @brief over the high watermark and not drained to the low one yet, producers should hold off.
+        BANKER_NODISCARD bool is_send_paused() const
+        {
+            return _send_state.paused;
+        }
+
+        /// @brief the disconnect overflow policy tripped, drop the connection.
+        BANKER_NODISCARD bool send_overflowed() const
+        {
+            return _send_state.overflowed;
+        }
+
+        enqueue_result enqueue(const std::vector<uint8_t>& data)
+        {
+            return stream_socket_core::enqueue(_send_state,data);
+        }
+
+        enqueue_result enqueue(std::vector<uint8_t>&& data)
+        {
+            return stream_socket_core::enqueue(_send_state, std::move(data));
+        }
+
+        /// @brief queues pooled bytes (for example a serialized pooled_packet) without copying them.
+        /// @note a template so brace initialized calls ( enqueue({begin, end}) ) keep picking the vector overload.
+        template<typename Bytes,
+                 std::enable_if_t<std::is_same_v<std::remove_cvref_t<Bytes>, pooled_bytes>, int> = 0>
+        enqueue_result enqueue(Bytes&& data)
         {
-            stream_socket_core::enqueue(_send_state,data);
+            return stream_socket_core::enqueue(_send_state, pooled_bytes(std::forward<Bytes>(data)));
         }
 
-        void enqueue(std::vector<uint8_t>&& data)
+        /// @brief queues a packet as a frame, the payload is moved in and not serialized / copied.
+        /// @param pkt left empty.
+        template<typename Allocator>
+        enqueue_result enqueue_packet(basic_packet<Allocator>&& pkt)
         {
-            stream_socket_core::enqueue(_send_state, std::move(data));
+            return stream_socket_core::enqueue_packet(_send_state, std::move(pkt));
         }
 
+        /// @brief queues several packets as one frame (read back as one packet), nothing is copied.
+        /// @param packets left empty.
+        template<typename Allocator>
+        enqueue_result enqueue_packets(const std::span<basic_packet<Allocator>> packets)
+        {
+            return stream_socket_core::enqueue_packets(_send_state, packets);
+        }
+
+        /// @brief queues a payload that can be queued on other sockets as well, without copying it.
+        /// @note make one with make_shared_bytes(), it is freed after the last socket sent it.
+        enqueue_result enqueue(shared_bytes data)
+        {
+            return stream_socket_core::enqueue(_send_state, std::move(data));
+        }
+
+        /// @brief sets the session used by enqueue_sealed() / open_sealed().
+        void set_session(crypto_session&& session)
+        {
+            _session = std::move(session);
+        }
+
+        BANKER_NODISCARD crypto_session& session()
+        {
+            return _session;
+        }
+
+        /// @brief encrypts the packet in place and queues it as an encrypted frame, nothing is copied.
+        /// @param pkt left empty (untouched when rejected).
+        /// @return rejected without a valid session (no set_session(), or a forged frame broke it).
+        template<typename Allocator>
+        enqueue_result enqueue_sealed(basic_packet<Allocator>&& pkt)
+        {
+            return crypto_stream_core::enqueue_sealed(_send_state, _session, std::move(pkt));
+        }
+
+        /// @brief encrypts 'payload' straight into the transmit buffer and queues it as an encrypted frame.
+        /// @return rejected without a valid session.
+        enqueue_result enqueue_sealed(const std::span<const uint8_t> payload)
+        {
+            return crypto_stream_core::enqueue_sealed(_send_state, _session, payload);
+        }
+
+        /// @brief decrypts the next received encrypted frame in place, the frame returned by
+        /// the previous call is dropped from receive() first.
+        /// @param payload set to the plaintext on ok, valid until the next open_sealed() or tick().
+        /// @return incomplete -> wait for more data, forged -> drop the connection.
+        crypto_stream_core::open_result open_sealed(packet_view& payload)
+        {
+            _receive_state.receive_buffer.consume(_sealed_frame_size);
+            _sealed_frame_size = 0;
+
+            std::span<uint8_t> bytes{};
+            const auto r = crypto_stream_core::open_sealed(
+                _receive_state.receive_buffer, _session, bytes, _sealed_frame_size);
+
+            if (r == crypto_stream_core::open_result::ok) payload = packet_view(bytes);
+            return r;
+        }
+
+        /// @brief reads and / or writes what the socket allows.
+        /// @param result error once the send queue overflowed under the disconnect policy.
         size_t tick(
             const bool readable = true,
             const bool writable = true,
             tcp::request_result* result = nullptr)
         {
-            tcp::request_result local_result;
+            tcp::request_result local_result = tcp::request_result::ok;
             size_t new_data = 0;
+            if ( _send_state.overflowed )
+            {
+                local_result = tcp::request_result::error;
+                goto stream_socket_tick_return;
+            }
             if ( readable )
             {
                 new_data =
@@ -97,6 +216,8 @@ namespace banker::networker
         socket _socket;
         stream_socket_core::receive_state   _receive_state;
         stream_socket_core::send_state      _send_state;
+        crypto_session                      _session;
+        size_t                              _sealed_frame_size{0};
 
     public:
         class acceptor
@@ -128,9 +249,10 @@ namespace banker::networker
                 return _socket.is_readable(timeout_ms);
             }
 
+            /// @brief the accepted connection is non blocking, like every other stream_socket.
             BANKER_NODISCARD stream_socket accept()
             {
-                return stream_socket{_socket.accept()};
+                return stream_socket{stream_socket_core::new_accepted_socket(_socket)};
             }
 
             BANKER_NODISCARD socket& raw_socket()
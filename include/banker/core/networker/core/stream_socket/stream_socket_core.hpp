@@ -12,7 +12,10 @@
 #include <deque>
 #include <vector>
 
+#include "banker/common/containers/buffer_pool.hpp"
+#include "banker/core/networker/core/packet/packet.hpp"
 #include "banker/core/networker/core/socket/socket.hpp"
+#include "banker/core/networker/core/stream_socket/stream_receive_buffer.hpp"
 #include "banker/core/networker/core/stream_socket/stream_transmit_buffer.hpp"
 #include "banker/core/networker/core/tcp/tcp_operations.hpp"
 
@@ -21,17 +24,87 @@ namespace banker::networker
     class stream_socket_core
     {
     public:
+        /// @brief what happens to an enqueue that would take the queue past send_limits::max_queued.
+        enum class overflow_policy : uint8_t
+        {
+            /// @brief the new frame is refused, the producer holds on to it until the queue drains.
+            reject,
+
+            /// @brief the oldest frames that haven't started sending are dropped to make room.
+            /// @note sealed frames can't be dropped (the session's nonces would go out of step),
+            /// crypto_stream_core::enqueue_sealed() treats this as disconnect.
+            drop_oldest,
+
+            /// @brief nothing is queued and the state is marked overflowed, the owner drops the connection.
+            disconnect
+        };
+
+        enum class enqueue_result : uint8_t
+        {
+            /// @brief queued.
+            queued,
+
+            /// @brief queued, but the queue is at or over the high watermark, stop producing.
+            paused,
+
+            /// @brief nothing was queued (reject, or a frame larger than max_queued).
+            rejected,
+
+            /// @brief nothing was queued, the disconnect policy tripped.
+            overflow
+        };
+
+        /// @brief per connection send queue limits, all 0 -> unlimited (the default).
+        struct send_limits
+        {
+            /// @brief queued bytes at which the state turns paused, 0 -> never.
+            size_t              high_watermark{0};
+
+            /// @brief queued bytes at (or under) which a paused state resumes.
+            size_t              low_watermark{0};
+
+            /// @brief queued bytes an enqueue may not go past, 0 -> no limit.
+            size_t              max_queued{0};
+
+            overflow_policy     policy{overflow_policy::reject};
+        };
+
         struct receive_state
         {
-            std::vector<uint8_t>                receive_buffer{};
+            stream_receive_buffer               receive_buffer{};
         };
 
         struct send_state
         {
-            std::deque<stream_transmit_buffer>  out_buffers{};
+            std::deque<stream_transmit_buffer, pool_allocator<stream_transmit_buffer>>  out_buffers{};
             size_t                              offset{0};
+
+            /// @brief what's left of out_buffers, kept in sync by enqueue() / consume_sent() / clear_send().
+            /// @details [iovec_head, iovecs.size()) maps 1:1 to out_buffers, the front one already skips offset.
+            /// the vector keeps its capacity so flushing doesn't allocate once it's warm.
+            std::vector<socket::native_iovec>   iovecs{};
+            size_t                              iovec_head{0};
+
+            /// @brief bytes in out_buffers that haven't been sent yet.
+            size_t                              queued_bytes{0};
+
+            send_limits                         limits{};
+
+            /// @brief crossed the high watermark and hasn't drained to the low one yet.
+            bool                                paused{false};
+
+            /// @brief the disconnect policy tripped.
+            bool                                overflowed{false};
+
+            /// @brief frames thrown away by drop_oldest.
+            size_t                              dropped_frames{0};
         };
 
+        BANKER_NODISCARD static bool was_queued(const enqueue_result r)
+        {
+            return r == enqueue_result::queued || r == enqueue_result::paused;
+        }
+
         static socket new_client_socket(
             const std::string& ip,
             const uint16_t port)
@@ -49,13 +122,15 @@ namespace banker::networker
         static socket new_server_socket(
             const std::string& ip,
             const unsigned short port,
-            const int backlog = 1024)
+            const int backlog = 1024,
+            const bool reuse_port = false)
         {
             socket s{};
 
             if ( !s.create(
                 socket::domain::inet, socket::type::stream) )   return socket{};
             if ( !s.set_reuse_address(true) )                   return socket{};
+            if ( reuse_port && !s.set_reuse_port(true) )        return socket{};
             if ( !s.bind(port, ip) )                            return socket{};
             if ( !s.listen(backlog) )                           return socket{};
             if ( !s.set_blocking(false) )                       return socket{};
@@ -73,20 +148,155 @@ namespace banker::networker
             return s;
         }
 
-        static void enqueue(
+        static enqueue_result enqueue(
             send_state& state,
             const std::vector<uint8_t>& data)
         {
-            state.out_buffers.emplace_back(data);
+            return _enqueue_one(state, stream_transmit_buffer{data});
         }
 
-        static void enqueue(
+        static enqueue_result enqueue(
             send_state& state,
             std::vector<uint8_t>&& data)
         {
-            state.out_buffers.emplace_back(std::move(data));
+            return _enqueue_one(state, stream_transmit_buffer{std::move(data)});
         }
 
+        /// @brief queues an already built transmit buffer (inline headers ...).
+        static enqueue_result enqueue(
+            send_state& state,
+            stream_transmit_buffer&& buffer)
+        {
+            return _enqueue_one(state, std::move(buffer));
+        }
+
+        /// @brief queues pooled bytes (for example a serialized pooled_packet), no copy is made.
+        static enqueue_result enqueue(
+            send_state& state,
+            pooled_bytes&& data)
+        {
+            return _enqueue_one(state, stream_transmit_buffer{std::move(data)});
+        }
+
+        /// @brief queues a packet as a frame without serializing it: the header goes inline
+        /// and the payload is moved in, so no payload bytes are copied.
+        /// @param pkt the packet, left empty (unless nothing was queued).
+        template<typename Allocator>
+        static enqueue_result enqueue_packet(
+            send_state& state,
+            basic_packet<Allocator>&& pkt)
+        {
+            const auto header = basic_packet<Allocator>::header_to_net(pkt.generate_header());
+
+            const enqueue_result admitted = admit(state, sizeof(header) + pkt.get_data().size());
+            if (!was_queued(admitted)) return admitted;
+
+            return push_frame(
+                state,
+                stream_transmit_buffer::inline_copy(&header, sizeof(header)),
+                stream_transmit_buffer{pkt.release()});
+        }
+
+        /// @brief queues several packets as one frame (one header, the payloads back to back),
+        /// the receiver reads it as a single packet. nothing is copied.
+        /// @param packets the packets, left empty (unless nothing was queued).
+        template<typename Allocator>
+        static enqueue_result enqueue_packets(
+            send_state& state,
+            const std::span<basic_packet<Allocator>> packets)
+        {
+            if (packets.empty()) return enqueue_result::queued;
+
+            const auto header = basic_packet<Allocator>::header_to_net(
+                basic_packet<Allocator>::generate_header_from(packets));
+
+            size_t bytes = sizeof(header);
+            for (const auto& pkt : packets) bytes += pkt.get_data().size();
+
+            const enqueue_result admitted = admit(state, bytes);
+            if (!was_queued(admitted)) return admitted;
+
+            _push_out(state, stream_transmit_buffer::inline_copy(&header, sizeof(header)), true);
+            for (auto& pkt : packets)
+                _push_out(state, stream_transmit_buffer{pkt.release()}, false);
+            return _pressure(state);
+        }
+
+        /// @brief queues a shared payload, it is referenced, not copied.
+        static enqueue_result enqueue(
+            send_state& state,
+            shared_bytes data)
+        {
+            return _enqueue_one(state, stream_transmit_buffer{std::move(data)});
+        }
+
+        /// @brief checks a frame of 'bytes' against state.limits and applies the overflow policy.
+        /// @details for callers that do work (sealing ...) only once the frame is sure to be queued,
+        /// follow an admitted frame up with push_frame().
+        /// @return queued / paused -> there is room now.
+        static enqueue_result admit(
+            send_state& state,
+            const size_t bytes)
+        {
+            return admit(state, bytes, state.limits.policy);
+        }
+
+        /// @brief admit() with 'policy' in place of state.limits.policy.
+        static enqueue_result admit(
+            send_state& state,
+            const size_t bytes,
+            const overflow_policy policy)
+        {
+            const size_t max = state.limits.max_queued;
+            if (max == 0 || state.queued_bytes + bytes <= max) return enqueue_result::queued;
+
+            switch (policy)
+            {
+                case overflow_policy::reject:
+                    return enqueue_result::rejected;
+
+                case overflow_policy::disconnect:
+                    state.overflowed = true;
+                    return enqueue_result::overflow;
+
+                case overflow_policy::drop_oldest:
+                    if (bytes > max) return enqueue_result::rejected;
+                    _drop_oldest(state, state.queued_bytes + bytes - max);
+                    return state.queued_bytes + bytes <= max
+                        ? enqueue_result::queued
+                        : enqueue_result::rejected;
+            }
+            return enqueue_result::rejected;
+        }
+
+        /// @brief queues a frame of one or two parts without checking the limits (see admit()).
+        /// @return queued or paused.
+        static enqueue_result push_frame(
+            send_state& state,
+            stream_transmit_buffer&& head,
+            stream_transmit_buffer&& body = stream_transmit_buffer{})
+        {
+            const bool head_queued = _push_out(state, std::move(head), true);
+            _push_out(state, std::move(body), !head_queued);
+            return _pressure(state);
+        }
+
+        /// @brief drops everything that is still queued.
+        static void clear_send(
+            send_state& state)
+        {
+            state.out_buffers.clear();
+            state.offset = 0;
+            state.iovecs.clear();
+            state.iovec_head = 0;
+            state.queued_bytes = 0;
+            state.paused = false;
+        }
+
+        /// @brief reads everything available straight into the receive buffer.
+        /// @tparam group_byte_limit minimum free space offered to the OS per read.
+        /// @param byte_limit stop reading after this many bytes (more can come in with the last read).
+        /// @return amount of new bytes in state.receive_buffer.
         template<size_t group_byte_limit = 1024 * 16>
         static size_t receive(
             socket& socket,
@@ -97,19 +307,19 @@ namespace banker::networker
             BANKER_SAFE(request_result) = tcp::request_result::ok;
 
             size_t bytes_received = 0;
-            uint8_t stack_buffer[ group_byte_limit ];
+            std::span<uint8_t> free_space[2];
 
-            int bytes = socket.recv(stack_buffer, group_byte_limit);
-            while ( bytes > 0 && bytes_received < byte_limit )
+            int bytes = 0;
+            do
             {
-                bytes_received += static_cast<size_t>(bytes);
-                state.receive_buffer.insert(
-                    state.receive_buffer.end(),
-                    stack_buffer,
-                    stack_buffer + bytes);
+                const size_t count = state.receive_buffer.prepare(group_byte_limit, free_space);
+                bytes = socket.recvv(free_space, count);
+                if (bytes <= 0) break;
 
-                bytes = socket.recv(stack_buffer, group_byte_limit);
+                state.receive_buffer.commit(static_cast<size_t>(bytes));
+                bytes_received += static_cast<size_t>(bytes);
             }
+            while ( bytes_received < byte_limit );
 
             if (bytes < 0)
             {
@@ -137,53 +347,175 @@ namespace banker::networker
             if (state.out_buffers.empty())
                 return 0;
 
-            std::vector<socket::iovec_c> io_vecs;
-            io_vecs.reserve(state.out_buffers.size());
-
-            io_vecs.emplace_back(state.out_buffers[0].to_iovec(state.offset));
-            for (size_t i = 1; i < state.out_buffers.size(); ++i)
-                io_vecs.emplace_back(state.out_buffers[i].to_iovec(0));
-
-            const int bytes = socket.sendv(io_vecs.data(), io_vecs.size());
+            // at most socket::max_iovecs go out per call, the rest waits for the next flush.
+            const int bytes = socket.sendv_native(
+                state.iovecs.data() + state.iovec_head,
+                state.iovecs.size() - state.iovec_head);
             if (bytes < 0)
             {
                 if (get_last_socket_error() == socket_error_code::would_block)
                     return 0;
 
-                state.out_buffers.clear();
-                state.offset = 0;
+                clear_send(state);
                 BANKER_SAFE(request_result) = tcp::request_result::error;
                 return 0;
             }
 
             if (bytes == 0)
             {
-                state.out_buffers.clear();
-                state.offset = 0;
+                clear_send(state);
                 BANKER_SAFE(request_result) = tcp::request_result::graceful_close;
             }
 
-            auto remaining = static_cast<size_t>(bytes);
+            const size_t buffers_sent =
+                consume_sent(state, static_cast<size_t>(bytes));
+
+            return (buffers_sent);
+        }
+
+        /// @brief advances the send state past bytes that were written to the socket.
+        /// @param state the send state the bytes were taken from.
+        /// @param bytes amount of bytes the OS accepted.
+        /// @return amount of buffers that got fully sent (and released).
+        static size_t consume_sent(
+            send_state& state,
+            size_t bytes)
+        {
             size_t buffers_sent = 0;
 
-            while ( remaining > 0 && !state.out_buffers.empty() )
+            while ( bytes > 0 && !state.out_buffers.empty() )
             {
                 auto& buf = state.out_buffers.front();
                 size_t available = buf.size(state.offset);
 
-                const size_t consumed = std::min(available, remaining);
+                const size_t consumed = std::min(available, bytes);
                 state.offset += consumed;
-                remaining -= consumed;
+                state.queued_bytes -= consumed;
+                bytes -= consumed;
 
                 if (state.offset >= buf.size(0))
                 {
                     state.out_buffers.pop_front();
                     state.offset = 0;
+                    ++state.iovec_head;
                     buffers_sent++;
                 }
+                else
+                {
+                    state.iovecs[state.iovec_head] = _to_native_iovec(buf, state.offset);
+                }
             }
 
-            return (buffers_sent);
+            if (state.out_buffers.empty())
+            {
+                state.iovecs.clear();
+                state.iovec_head = 0;
+            }
+            else if (state.iovec_head >= _iovec_compact_threshold &&
+                     state.iovec_head * 2 >= state.iovecs.size())
+            {
+                // drop the sent part once it's at least half, keeps this amortized O(1).
+                state.iovecs.erase(
+                    state.iovecs.begin(),
+                    state.iovecs.begin() + static_cast<std::ptrdiff_t>(state.iovec_head));
+                state.iovec_head = 0;
+            }
+
+            if (state.paused && state.queued_bytes <= state.limits.low_watermark)
+                state.paused = false;
+
+            return buffers_sent;
+        }
+
+    private:
+        static constexpr size_t _iovec_compact_threshold = 64;
+
+        static socket::native_iovec _to_native_iovec(
+            const stream_transmit_buffer& buffer,
+            const size_t offset)
+        {
+            return socket::make_native_iovec(buffer.data(offset), buffer.size(offset));
+        }
+
+        /// @return if the buffer was queued.
+        static bool _push_out(
+            send_state& state,
+            stream_transmit_buffer&& buffer,
+            const bool frame_start)
+        {
+            // an empty buffer would never be consumed (and would look like a close to writev).
+            if (buffer.size(0) == 0) return false;
+
+            if (!frame_start) buffer.continue_frame();
+            state.queued_bytes += buffer.size(0);
+
+            // the iovec is taken after the move, inline bytes live inside the queued buffer.
+            state.out_buffers.emplace_back(std::move(buffer));
+            state.iovecs.push_back(_to_native_iovec(state.out_buffers.back(), 0));
+            return true;
+        }
+
+        static enqueue_result _enqueue_one(
+            send_state& state,
+            stream_transmit_buffer&& buffer)
+        {
+            const enqueue_result admitted = admit(state, buffer.size(0));
+            if (!was_queued(admitted)) return admitted;
+
+            _push_out(state, std::move(buffer), true);
+            return _pressure(state);
+        }
+
+        /// @brief updates the paused flag after queueing.
+        static enqueue_result _pressure(send_state& state)
+        {
+            const size_t high = state.limits.high_watermark;
+            if (high != 0 && state.queued_bytes >= high) state.paused = true;
+            return state.paused ? enqueue_result::paused : enqueue_result::queued;
+        }
+
+        /// @brief drops whole frames from the front until 'bytes' are freed, a frame that
+        /// started sending is kept (cutting it would corrupt the stream).
+        static void _drop_oldest(
+            send_state& state,
+            size_t bytes)
+        {
+            auto& buffers = state.out_buffers;
+
+            // skip the frame that is partly sent.
+            size_t first = 0;
+            if (state.offset != 0 || (!buffers.empty() && !buffers.front().is_frame_start()))
+            {
+                first = 1;
+                while (first < buffers.size() && !buffers[first].is_frame_start()) ++first;
+            }
+
+            size_t last = first;
+            while (last < buffers.size() && bytes > 0)
+            {
+                // whole frame [last, end).
+                size_t end = last + 1;
+                size_t frame_bytes = buffers[last].size(0);
+                while (end < buffers.size() && !buffers[end].is_frame_start())
+                    frame_bytes += buffers[end++].size(0);
+
+                state.queued_bytes -= frame_bytes;
+                bytes -= std::min(bytes, frame_bytes);
+                ++state.dropped_frames;
+                last = end;
+            }
+
+            if (last == first) return;
+
+            buffers.erase(
+                buffers.begin() + static_cast<std::ptrdiff_t>(first),
+                buffers.begin() + static_cast<std::ptrdiff_t>(last));
+
+            // erasing moves buffers around (and inline bytes with them), so the iovecs are rebuilt.
+            state.iovecs.clear();
+            state.iovec_head = 0;
+            for (size_t i = 0; i < buffers.size(); ++i)
+                state.iovecs.push_back(_to_native_iovec(buffers[i], i == 0 ? state.offset : 0));
         }
     };
 }
@@ -12,10 +12,14 @@
 #include <memory>
 #include <vector>
 
+#include "banker/common/containers/variant_buffer.hpp"
+#include "banker/core/networker/core/socket/socket.hpp"
 #include "banker/shared/compat.hpp"
 
 namespace banker::networker
 {
+    /// @brief one queued outgoing payload, either owned or shared with other sockets (see shared_bytes).
+    /// @note copies are made into pooled_bytes, so they come out of the thread's buffer_pool.
     class stream_transmit_buffer
     {
     public:
@@ -29,23 +33,39 @@ namespace banker::networker
         stream_transmit_buffer& operator=(stream_transmit_buffer&& other) noexcept = default;
 
         explicit stream_transmit_buffer(const std::vector<uint8_t>& buffer)
-        {
-            _buffer = buffer;
-        }
+            : _buffer(pooled_bytes(buffer.begin(), buffer.end())) {}
 
         explicit stream_transmit_buffer(std::vector<uint8_t>&& buffer) noexcept
+            : _buffer(std::move(buffer)) {}
+
+        explicit stream_transmit_buffer(const uint8_t* data, const size_t size)
+            : _buffer(pooled_bytes(data, data + size)) {}
+
+        explicit stream_transmit_buffer(pooled_bytes&& buffer) noexcept
+            : _buffer(std::move(buffer)) {}
+
+        /// @brief references a shared payload, no copy is made.
+        explicit stream_transmit_buffer(shared_bytes buffer) noexcept
+            : _buffer(std::move(buffer)) {}
+
+        /// @brief copies a few bytes into the buffer itself (more than variant_buffer::inline_capacity
+        /// go into an owned vector instead).
+        /// @note meant for frame headers, the bytes move with the buffer so only use it for
+        /// buffers that stay put once queued (send_state's deque).
+        static stream_transmit_buffer inline_copy(const void* data, const size_t size)
         {
-            _buffer = std::move(buffer);
+            return stream_transmit_buffer{variant_buffer::make_inline(data, size)};
         }
 
-        explicit stream_transmit_buffer(const uint8_t* data, const size_t size) noexcept
+        /// @brief if the payload is shared with other buffers.
+        BANKER_NODISCARD bool is_shared() const
         {
-            _buffer = std::vector(data, data + size);
+            return _buffer.is_shared();
         }
 
-        BANKER_NODISCARD uint8_t* data(const size_t offset) const
+        BANKER_NODISCARD const uint8_t* data(const size_t offset) const
         {
-            return const_cast<uint8_t *>(_buffer.data() + offset);
+            return _buffer.data() + offset;
         }
 
         BANKER_NODISCARD socket::iovec_c to_iovec(const size_t offset) const
@@ -60,6 +80,18 @@ namespace banker::networker
             return _buffer.size() - offset;
         }
 
+        /// @brief if this buffer starts a frame (one enqueue call), false for the parts after the first.
+        BANKER_NODISCARD bool is_frame_start() const
+        {
+            return !_continuation;
+        }
+
+        /// @brief marks the buffer as a later part of the frame queued before it.
+        void continue_frame()
+        {
+            _continuation = true;
+        }
+
         BANKER_NODISCARD size_t consume(
             const size_t bytes,
             size_t& offset) const
@@ -79,7 +111,11 @@ namespace banker::networker
         }
 
     private:
-        std::vector<uint8_t> _buffer{};
+        variant_buffer _buffer{};
+        bool _continuation{false};
+
+        explicit stream_transmit_buffer(variant_buffer&& buffer) noexcept
+            : _buffer(std::move(buffer)) {}
     };
 }
 
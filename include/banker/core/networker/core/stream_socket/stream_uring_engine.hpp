@@ -0,0 +1,476 @@
+/* ================================== *\
+ @file     stream_uring_engine.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_STREAM_URING_ENGINE_HPP
+#define BANKER_STREAM_URING_ENGINE_HPP
+
+#include "banker/shared/compat.hpp"
+
+#ifdef BANKER_PLATFORM_LINUX
+
+#include <cstdint>
+#include <vector>
+
+#include "banker/core/networker/core/socket/socket.hpp"
+#include "banker/core/networker/core/stream_socket/stream_socket_core.hpp"
+#include "banker/core/networker/core/tcp/tcp_operations.hpp"
+#include "banker/core/networker/core/uring/uring.hpp"
+#include "banker/shared/program_macros.hpp"
+
+namespace banker::networker
+{
+    /// @brief completion based alternative to ticking every stream_socket.
+    /// @details owns its connections, every tick() submits all queued accept / recv / writev work
+    /// in a single io_uring_enter and reaps the completions. accept and recv are multishot and
+    /// recv reads into a registered buffer ring, so an idle connection costs no syscalls at all.
+    /// @code{.cpp}
+    /// stream_uring_engine engine{};
+    /// engine.listen(stream_socket_core::new_server_socket("0.0.0.0", 8080));
+    /// while (true)
+    /// {
+    ///     engine.tick(100);
+    ///     stream_uring_engine::completion c;
+    ///     while (engine.next_completion(c))
+    ///     {
+    ///         if (c.type == stream_uring_engine::event::received) engine.receive(c.id).clear();
+    ///         if (c.type == stream_uring_engine::event::closed)   engine.close(c.id);
+    ///     }
+    /// }
+    /// @endcode
+    class stream_uring_engine
+    {
+    public:
+        using connection_id = uint64_t;
+        static constexpr connection_id invalid_connection = ~0ULL;
+
+        enum class event : uint8_t
+        {
+            /// @brief a new connection got accepted, 'id' is ready for use.
+            accepted,
+
+            /// @brief 'bytes' new bytes got appended to receive(id).
+            received,
+
+            /// @brief 'bytes' bytes of the queued data got written.
+            sent,
+
+            /// @brief the connection is done, 'result' says why. call close(id) to release it.
+            closed,
+        };
+
+        struct completion
+        {
+            event                   type{event::closed};
+            connection_id           id{invalid_connection};
+            size_t                  bytes{0};
+            tcp::request_result     result{tcp::request_result::ok};
+        };
+
+        struct config
+        {
+            /// @brief submission queue size.
+            unsigned    entries{1024};
+
+            /// @brief amount of registered receive buffers (power of 2).
+            uint16_t    buffer_count{1024};
+
+            /// @brief size of each registered receive buffer.
+            uint32_t    buffer_size{1024 * 16};
+        };
+
+    public:
+        stream_uring_engine()
+        {
+            _create(config{});
+        }
+
+        explicit stream_uring_engine(const config& cfg)
+        {
+            _create(cfg);
+        }
+
+        ~stream_uring_engine() = default;
+
+        stream_uring_engine(const stream_uring_engine&)             = delete;
+        stream_uring_engine& operator=(const stream_uring_engine&)  = delete;
+
+        stream_uring_engine(stream_uring_engine&&)                  = delete;
+        stream_uring_engine& operator=(stream_uring_engine&&)       = delete;
+
+        /// @brief false if the kernel doesn't support io_uring (or provided buffer rings, linux 5.19+).
+        BANKER_NODISCARD bool is_valid() const { return _valid; }
+
+        /// @brief starts accepting on a listening socket (multishot).
+        /// @param listener a listening socket, see stream_socket_core::new_server_socket.
+        /// @return true -> accept armed, false -> invalid listener or engine.
+        bool listen(socket&& listener)
+        {
+            if (!_valid || !listener.is_valid()) return false;
+            _listener = std::move(listener);
+            return _arm_accept();
+        }
+
+        /// @brief hands an already connected socket to the engine.
+        /// @return the id of the connection, or invalid_connection.
+        connection_id add(socket&& s)
+        {
+            if (!_valid || !s.is_valid()) return invalid_connection;
+
+            uint32_t index;
+            if (!_free.empty())
+            {
+                index = _free.back();
+                _free.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(_connections.size());
+                _connections.emplace_back();
+            }
+
+            connection& c = _connections[index];
+            c.sock = std::move(s);
+            c.used = true;
+            c.closing = false;
+            c.released = false;
+
+            const connection_id id = _make_id(index, c.generation);
+            _arm_receive(index);
+            return id;
+        }
+
+        /// @brief queues data, it gets written on the next tick().
+        void enqueue(const connection_id id, std::vector<uint8_t>&& data)
+        {
+            connection* c = _get(id);
+            if (c == nullptr || c->closing) return;
+            stream_socket_core::enqueue(c->send_state, std::move(data));
+            _mark_write(_index_of(id));
+        }
+
+        /// @brief queues data, it gets written on the next tick().
+        void enqueue(const connection_id id, const std::vector<uint8_t>& data)
+        {
+            connection* c = _get(id);
+            if (c == nullptr || c->closing) return;
+            stream_socket_core::enqueue(c->send_state, data);
+            _mark_write(_index_of(id));
+        }
+
+        /// @brief queues a shared payload without copying it, it gets written on the next tick().
+        void enqueue(const connection_id id, shared_bytes data)
+        {
+            connection* c = _get(id);
+            if (c == nullptr || c->closing) return;
+            stream_socket_core::enqueue(c->send_state, std::move(data));
+            _mark_write(_index_of(id));
+        }
+
+        /// @brief the receive buffer of a connection, new data is appended to the back.
+        /// @warning id must be valid.
+        BANKER_NODISCARD stream_receive_buffer& receive(const connection_id id)
+        {
+            connection* c = _get(id);
+            BANKER_ASSERT(c != nullptr);
+            return c->receive_state.receive_buffer;
+        }
+
+        BANKER_NODISCARD bool contains(const connection_id id) const
+        {
+            const uint32_t index = _index_of(id);
+            return index < _connections.size()
+                && _connections[index].used
+                && _connections[index].generation == _generation_of(id);
+        }
+
+        /// @brief shuts the connection down and releases it once the kernel is done with it.
+        void close(const connection_id id)
+        {
+            connection* c = _get(id);
+            if (c == nullptr || c->released) return;
+
+            c->released = true;
+            if (!c->closing)
+            {
+                c->closing = true;
+                // ends the multishot recv and any writev in flight, their completions finish the close.
+                ::shutdown(c->sock.to_fd(), SHUT_RDWR);
+            }
+            _try_release(_index_of(id));
+        }
+
+        /// @brief submits all queued work and reaps the completions (one syscall).
+        /// @param timeout_ms how long to wait for a completion, 0 returns immediately, -1 waits forever.
+        /// @return amount of completions that can be read with next_completion().
+        size_t tick(const int timeout_ms = 0)
+        {
+            _completions.clear();
+            _read_offset = 0;
+            if (!_valid) return 0;
+
+            _submit_writes();
+            _ring.submit(timeout_ms == 0 ? 0 : 1, timeout_ms);
+
+            while (const io_uring_cqe* cqe = _ring.peek())
+            {
+                const io_uring_cqe copy = *cqe;
+                _ring.seen();
+                _handle(copy);
+            }
+
+            _buffers.publish();
+            return _completions.size();
+        }
+
+        /// @brief reads the next completion from the last tick().
+        /// @return true -> 'result' got filled, false -> no more completions.
+        bool next_completion(completion& result)
+        {
+            if (_read_offset >= _completions.size()) return false;
+            result = _completions[_read_offset++];
+            return true;
+        }
+
+    private:
+        enum class op : uint8_t
+        {
+            accept  = 1,
+            receive = 2,
+            write   = 3,
+        };
+
+        struct connection
+        {
+            socket                              sock{};
+            stream_socket_core::receive_state   receive_state{};
+            stream_socket_core::send_state      send_state{};
+
+            /// @brief iovecs of the writev in flight, must stay alive until it completes.
+            std::vector<::iovec>                iovecs{};
+
+            uint32_t                            generation{0};
+            uint8_t                             in_flight{0};
+            bool                                used{false};
+            bool                                closing{false};
+            bool                                released{false};
+            bool                                writing{false};
+            bool                                write_queued{false};
+        };
+
+        uring::buffer_ring          _buffers{};
+        bool                        _valid{false};
+
+        socket                      _listener{};
+        std::vector<connection>     _connections{};
+        std::vector<uint32_t>       _free{};
+        std::vector<uint32_t>       _write_queue{};
+
+        std::vector<completion>     _completions{};
+        size_t                      _read_offset{0};
+
+        /// @brief declared last so it's destroyed first: the ring fd is closed (and the armed
+        /// multishot accept/recv cancelled) before the buffer ring and the iovecs are freed.
+        uring                       _ring{};
+
+        void _create(const config& cfg)
+        {
+            _valid = _ring.create(cfg.entries)
+                && _ring.register_buffer_ring(_buffers, 0, cfg.buffer_count, cfg.buffer_size);
+        }
+
+        static connection_id _make_id(const uint32_t index, const uint32_t generation)
+        {
+            return (static_cast<uint64_t>(generation) << 32) | index;
+        }
+
+        static uint32_t _index_of(const connection_id id) { return static_cast<uint32_t>(id); }
+
+        static uint32_t _generation_of(const connection_id id) { return static_cast<uint32_t>(id >> 32); }
+
+        /// @brief user_data layout: [op:8][generation:24][index:32].
+        static uint64_t _make_user_data(const op o, const uint32_t index, const uint32_t generation)
+        {
+            return (static_cast<uint64_t>(o) << 56)
+                | (static_cast<uint64_t>(generation & 0xFFFFFF) << 32)
+                | index;
+        }
+
+        connection* _get(const connection_id id)
+        {
+            return contains(id) ? &_connections[_index_of(id)] : nullptr;
+        }
+
+        bool _arm_accept()
+        {
+            io_uring_sqe* sqe = _ring.get_sqe_or_submit();
+            if (sqe == nullptr) return false;
+            sqe->opcode = IORING_OP_ACCEPT;
+            sqe->fd = _listener.to_fd();
+            sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+            sqe->user_data = _make_user_data(op::accept, 0, 0);
+            return true;
+        }
+
+        void _arm_receive(const uint32_t index)
+        {
+            connection& c = _connections[index];
+            io_uring_sqe* sqe = _ring.get_sqe_or_submit();
+            if (sqe == nullptr) return;
+            sqe->opcode = IORING_OP_RECV;
+            sqe->fd = c.sock.to_fd();
+            sqe->ioprio = IORING_RECV_MULTISHOT;
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = _buffers.group();
+            sqe->user_data = _make_user_data(op::receive, index, c.generation);
+            ++c.in_flight;
+        }
+
+        void _mark_write(const uint32_t index)
+        {
+            connection& c = _connections[index];
+            if (c.writing || c.write_queued) return;
+            c.write_queued = true;
+            _write_queue.push_back(index);
+        }
+
+        void _submit_writes()
+        {
+            for (const uint32_t index : _write_queue)
+            {
+                connection& c = _connections[index];
+                c.write_queued = false;
+                if (!c.used || c.closing || c.writing || c.send_state.out_buffers.empty()) continue;
+
+                // the kernel may read the iovecs after submit, so they get their own copy that
+                // stays put while more data is enqueued.
+                const auto& pending = c.send_state.iovecs;
+                const size_t head = c.send_state.iovec_head;
+                const size_t count = std::min(pending.size() - head, socket::max_iovecs);
+                c.iovecs.assign(
+                    pending.begin() + static_cast<std::ptrdiff_t>(head),
+                    pending.begin() + static_cast<std::ptrdiff_t>(head + count));
+
+                io_uring_sqe* sqe = _ring.get_sqe_or_submit();
+                if (sqe == nullptr) continue;
+                sqe->opcode = IORING_OP_WRITEV;
+                sqe->fd = c.sock.to_fd();
+                sqe->addr = reinterpret_cast<uint64_t>(c.iovecs.data());
+                sqe->len = static_cast<uint32_t>(count);
+                sqe->user_data = _make_user_data(op::write, index, c.generation);
+                c.writing = true;
+                ++c.in_flight;
+            }
+            _write_queue.clear();
+        }
+
+        void _push(const event type, const uint32_t index, const size_t bytes, const tcp::request_result result)
+        {
+            _completions.push_back(completion{
+                type,
+                _make_id(index, _connections[index].generation),
+                bytes,
+                result});
+        }
+
+        /// @brief reports the close once, later completions of the connection are swallowed.
+        void _fail(const uint32_t index, const tcp::request_result result)
+        {
+            connection& c = _connections[index];
+            if (c.closing) return;
+            c.closing = true;
+            ::shutdown(c.sock.to_fd(), SHUT_RDWR);
+            _push(event::closed, index, 0, result);
+        }
+
+        /// @brief frees the slot once the user closed it and the kernel has nothing left in flight.
+        void _try_release(const uint32_t index)
+        {
+            connection& c = _connections[index];
+            if (!c.released || c.in_flight != 0) return;
+
+            (void)c.sock.close();
+            c.receive_state.receive_buffer.clear();
+            stream_socket_core::clear_send(c.send_state);
+            c.used = false;
+            c.writing = false;
+            ++c.generation;
+            _free.push_back(index);
+        }
+
+        void _handle(const io_uring_cqe& cqe)
+        {
+            const auto o = static_cast<op>(cqe.user_data >> 56);
+            const auto index = static_cast<uint32_t>(cqe.user_data);
+            const bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+
+            if (o == op::accept)
+            {
+                if (cqe.res >= 0)
+                {
+                    const connection_id id = add(socket{static_cast<socket_t>(cqe.res)});
+                    if (id != invalid_connection)
+                        _push(event::accepted, _index_of(id), 0, tcp::request_result::ok);
+                }
+                if (!more && _listener.is_valid()) _arm_accept();
+                return;
+            }
+
+            if (index >= _connections.size()) return;
+            connection& c = _connections[index];
+            if ((c.generation & 0xFFFFFF) != ((cqe.user_data >> 32) & 0xFFFFFF)) return;
+
+            if (o == op::receive)
+            {
+                if (cqe.flags & IORING_CQE_F_BUFFER)
+                {
+                    const auto buffer_id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                    if (cqe.res > 0 && !c.closing)
+                    {
+                        const uint8_t* data = _buffers.data(buffer_id);
+                        c.receive_state.receive_buffer.append(data, static_cast<size_t>(cqe.res));
+                        _push(event::received, index, static_cast<size_t>(cqe.res), tcp::request_result::ok);
+                    }
+                    _buffers.recycle(buffer_id);
+                }
+
+                if (cqe.res == 0)
+                    _fail(index, tcp::request_result::graceful_close);
+                else if (cqe.res < 0 && cqe.res != -ENOBUFS)
+                    _fail(index, tcp::request_result::error);
+
+                if (!more)
+                {
+                    --c.in_flight;
+                    // out of buffers ends the multishot, it comes back once buffers got recycled.
+                    if (!c.closing) _arm_receive(index);
+                }
+            }
+            else if (o == op::write)
+            {
+                --c.in_flight;
+                c.writing = false;
+
+                if (cqe.res < 0)
+                {
+                    _fail(index, tcp::request_result::error);
+                }
+                else if (!c.closing)
+                {
+                    stream_socket_core::consume_sent(c.send_state, static_cast<size_t>(cqe.res));
+                    _push(event::sent, index, static_cast<size_t>(cqe.res), tcp::request_result::ok);
+                    if (!c.send_state.out_buffers.empty()) _mark_write(index);
+                }
+            }
+
+            _try_release(index);
+        }
+    };
+}
+
+#endif // BANKER_PLATFORM_LINUX
+
+#endif //BANKER_STREAM_URING_ENGINE_HPP
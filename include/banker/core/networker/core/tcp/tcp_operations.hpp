@@ -11,7 +11,7 @@
 #include <cstdint>
 
 #include "banker/core/networker/core/socket/socket.hpp"
-#include "banker/core/networker/core/socket/socket.hpp"
+#include "banker/shared/program_macros.hpp"
 
 namespace banker::networker::tcp
 {
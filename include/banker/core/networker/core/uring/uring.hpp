@@ -0,0 +1,361 @@
+/* ================================== *\
+ @file     uring.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_URING_HPP
+#define BANKER_URING_HPP
+
+#include "banker/shared/compat.hpp"
+
+#ifdef BANKER_PLATFORM_LINUX
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <linux/io_uring.h> // io_uring_params, io_uring_sqe, io_uring_cqe, ...
+#include <sys/mman.h>       // mmap(), munmap()
+#include <sys/syscall.h>    // __NR_io_uring_*
+#include <unistd.h>         // syscall(), close()
+#include <csignal>          // _NSIG
+
+namespace banker::networker
+{
+    /// @brief minimal io_uring wrapper (no liburing), owns the ring and its mappings.
+    /// @details sqes are batched locally with get_sqe() and handed to the kernel with one submit().
+    class uring
+    {
+    public:
+        /// @brief a kernel picked buffer pool (IORING_REGISTER_PBUF_RING), used with IOSQE_BUFFER_SELECT.
+        class buffer_ring
+        {
+        public:
+            buffer_ring()   = default;
+            ~buffer_ring()  { _release(); }
+
+            buffer_ring(const buffer_ring&)             = delete;
+            buffer_ring& operator=(const buffer_ring&)  = delete;
+
+            buffer_ring(buffer_ring&& other) noexcept { *this = std::move(other); }
+            buffer_ring& operator=(buffer_ring&& other) noexcept
+            {
+                if (this == &other) return *this;
+                _release();
+                _ring = other._ring;
+                _ring_bytes = other._ring_bytes;
+                _storage = std::move(other._storage);
+                _count = other._count;
+                _buffer_size = other._buffer_size;
+                _tail = other._tail;
+                _group = other._group;
+                other._ring = nullptr;
+                return *this;
+            }
+
+            BANKER_NODISCARD bool is_valid() const { return _ring != nullptr; }
+
+            BANKER_NODISCARD uint16_t group() const { return _group; }
+
+            BANKER_NODISCARD uint32_t buffer_size() const { return _buffer_size; }
+
+            /// @brief data of buffer 'id' (from the cqe flags).
+            BANKER_NODISCARD uint8_t* data(const uint16_t id)
+            {
+                return _storage.data() + static_cast<size_t>(id) * _buffer_size;
+            }
+
+            /// @brief gives buffer 'id' back to the kernel, only visible after publish().
+            void recycle(const uint16_t id)
+            {
+                io_uring_buf& buf = _bufs()[_tail & (_count - 1)];
+                buf.addr = reinterpret_cast<uint64_t>(data(id));
+                buf.len = _buffer_size;
+                buf.bid = id;
+                ++_tail;
+            }
+
+            /// @brief makes every recycled buffer visible to the kernel.
+            void publish()
+            {
+                __atomic_store_n(_tail_ptr(), _tail, __ATOMIC_RELEASE);
+            }
+
+        private:
+            friend class uring;
+
+            void* _ring{nullptr};
+            size_t _ring_bytes{0};
+            std::vector<uint8_t> _storage{};
+            uint16_t _count{0};
+            uint32_t _buffer_size{0};
+            uint16_t _tail{0};
+            uint16_t _group{0};
+
+            io_uring_buf* _bufs() { return static_cast<io_uring_buf*>(_ring); }
+
+            /// @brief the ring tail overlays bufs[0].resv.
+            uint16_t* _tail_ptr() { return &_bufs()[0].resv; }
+
+            void _release()
+            {
+                if (_ring != nullptr) ::munmap(_ring, _ring_bytes);
+                _ring = nullptr;
+            }
+        };
+
+    public:
+        uring()     = default;
+        ~uring()    { _release(); }
+
+        uring(const uring&)             = delete;
+        uring& operator=(const uring&)  = delete;
+
+        uring(uring&&)                  = delete;
+        uring& operator=(uring&&)       = delete;
+
+        /// @brief creates the ring.
+        /// @param entries submission queue size (rounded up to a power of 2 by the kernel).
+        /// @return true -> succeeded, false -> failed (kernel without io_uring, or it's disabled).
+        BANKER_NODISCARD bool create(const unsigned entries = 1024)
+        {
+            _release();
+
+            io_uring_params params{};
+            params.flags = IORING_SETUP_CQSIZE;
+            params.cq_entries = entries * 4;
+
+            const long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+            if (fd < 0) return false;
+            _fd = static_cast<int>(fd);
+            _features = params.features;
+
+            _sq_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            _cq_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+            const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap) _sq_bytes = _cq_bytes = std::max(_sq_bytes, _cq_bytes);
+
+            _sq_ptr = _map(_sq_bytes, IORING_OFF_SQ_RING);
+            if (_sq_ptr == nullptr) { _release(); return false; }
+
+            _cq_ptr = single_mmap ? _sq_ptr : _map(_cq_bytes, IORING_OFF_CQ_RING);
+            if (_cq_ptr == nullptr) { _release(); return false; }
+
+            _sqes_bytes = params.sq_entries * sizeof(io_uring_sqe);
+            _sqes = static_cast<io_uring_sqe*>(_map(_sqes_bytes, IORING_OFF_SQES));
+            if (_sqes == nullptr) { _release(); return false; }
+
+            auto* sq = static_cast<uint8_t*>(_sq_ptr);
+            _sq_head    = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            _sq_tail    = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            _sq_mask    = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            _sq_entries = params.sq_entries;
+
+            // sqes are always used in ring order, so the indirection array is identity.
+            auto* sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            for (unsigned i = 0; i < _sq_entries; ++i) sq_array[i] = i;
+
+            auto* cq = static_cast<uint8_t*>(_cq_ptr);
+            _cq_head    = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            _cq_tail    = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            _cq_mask    = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            _cqes       = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+            _sqe_tail = _sqe_submitted = *_sq_tail;
+            return true;
+        }
+
+        BANKER_NODISCARD bool is_valid() const { return _fd != -1; }
+
+        /// @brief a zeroed sqe, or nullptr if the submission queue is full (call submit() first).
+        BANKER_NODISCARD io_uring_sqe* get_sqe()
+        {
+            const unsigned head = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+            if (_sqe_tail - head >= _sq_entries) return nullptr;
+
+            io_uring_sqe* sqe = &_sqes[_sqe_tail & _sq_mask];
+            std::memset(sqe, 0, sizeof(io_uring_sqe));
+            ++_sqe_tail;
+            return sqe;
+        }
+
+        /// @brief a zeroed sqe, submits the pending ones first if the queue is full.
+        BANKER_NODISCARD io_uring_sqe* get_sqe_or_submit()
+        {
+            io_uring_sqe* sqe = get_sqe();
+            if (sqe != nullptr) return sqe;
+            submit();
+            return get_sqe();
+        }
+
+        /// @brief hands every pending sqe to the kernel and optionally waits for completions (one syscall).
+        /// @param wait_for minimum amount of completions to wait for.
+        /// @param timeout_ms max wait in ms, -1 waits forever (only used when wait_for > 0).
+        /// @return amount of sqes submitted, or -1 on error.
+        int submit(
+            const unsigned wait_for = 0,
+            const int timeout_ms = -1)
+        {
+            const unsigned to_submit = _sqe_tail - _sqe_submitted;
+            __atomic_store_n(_sq_tail, _sqe_tail, __ATOMIC_RELEASE);
+
+            if (to_submit == 0 && wait_for == 0) return 0;
+            if (wait_for > 0 && has_completion())
+                return to_submit == 0 ? 0 : static_cast<int>(_enter(to_submit, 0, 0, nullptr, 0));
+
+            unsigned flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+            __kernel_timespec ts{};
+            io_uring_getevents_arg arg{};
+            const void* arg_ptr = nullptr;
+            size_t arg_size = 0;
+
+            if (wait_for > 0 && timeout_ms >= 0 && (_features & IORING_FEAT_EXT_ARG) != 0)
+            {
+                ts.tv_sec = timeout_ms / 1000;
+                ts.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+                arg.sigmask_sz = _NSIG / 8;
+                arg.ts = reinterpret_cast<uint64_t>(&ts);
+                flags |= IORING_ENTER_EXT_ARG;
+                arg_ptr = &arg;
+                arg_size = sizeof(arg);
+            }
+
+            const long r = _enter(to_submit, wait_for, flags, arg_ptr, arg_size);
+            if (r < 0)
+            {
+                // timeouts and signals aren't errors, the sqes got consumed anyway.
+                if (errno == ETIME || errno == EINTR) return static_cast<int>(to_submit);
+                return -1;
+            }
+            return static_cast<int>(r);
+        }
+
+        BANKER_NODISCARD bool has_completion() const
+        {
+            return *_cq_head != __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        }
+
+        /// @brief the oldest unseen completion, or nullptr. call seen() when done with it.
+        BANKER_NODISCARD const io_uring_cqe* peek()
+        {
+            const unsigned head = *_cq_head;
+            if (head == __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE)) return nullptr;
+            return &_cqes[head & _cq_mask];
+        }
+
+        /// @brief releases the completion returned by peek().
+        void seen()
+        {
+            __atomic_store_n(_cq_head, *_cq_head + 1, __ATOMIC_RELEASE);
+        }
+
+        /// @brief registers a kernel picked buffer pool.
+        /// @param ring the ring to fill.
+        /// @param group buffer group id, put into sqe->buf_group.
+        /// @param count amount of buffers (power of 2, max 32768).
+        /// @param buffer_size size of each buffer.
+        /// @return true -> succeeded, false -> failed (needs linux 5.19+).
+        BANKER_NODISCARD bool register_buffer_ring(
+            buffer_ring& ring,
+            const uint16_t group,
+            const uint16_t count,
+            const uint32_t buffer_size)
+        {
+            if (count == 0 || (count & (count - 1)) != 0) return false;
+
+            ring._release();
+            ring._ring_bytes = static_cast<size_t>(count) * sizeof(io_uring_buf);
+            void* mem = ::mmap(nullptr, ring._ring_bytes,
+                PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+            if (mem == MAP_FAILED) return false;
+
+            ring._ring = mem;
+            ring._count = count;
+            ring._buffer_size = buffer_size;
+            ring._group = group;
+            ring._tail = 0;
+            ring._storage.assign(static_cast<size_t>(count) * buffer_size, 0);
+
+            io_uring_buf_reg reg{};
+            reg.ring_addr = reinterpret_cast<uint64_t>(mem);
+            reg.ring_entries = count;
+            reg.bgid = group;
+
+            if (::syscall(__NR_io_uring_register, _fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+            {
+                ring._release();
+                return false;
+            }
+
+            for (uint16_t i = 0; i < count; ++i) ring.recycle(i);
+            ring.publish();
+            return true;
+        }
+
+    private:
+        int _fd{-1};
+        uint32_t _features{0};
+
+        void* _sq_ptr{nullptr};
+        void* _cq_ptr{nullptr};
+        io_uring_sqe* _sqes{nullptr};
+        size_t _sq_bytes{0};
+        size_t _cq_bytes{0};
+        size_t _sqes_bytes{0};
+
+        unsigned* _sq_head{nullptr};
+        unsigned* _sq_tail{nullptr};
+        unsigned _sq_mask{0};
+        unsigned _sq_entries{0};
+
+        unsigned* _cq_head{nullptr};
+        unsigned* _cq_tail{nullptr};
+        unsigned _cq_mask{0};
+        io_uring_cqe* _cqes{nullptr};
+
+        /// @brief local tail, published to the kernel in submit().
+        unsigned _sqe_tail{0};
+        unsigned _sqe_submitted{0};
+
+        long _enter(
+            const unsigned to_submit,
+            const unsigned wait_for,
+            const unsigned flags,
+            const void* arg,
+            const size_t arg_size)
+        {
+            const long r = ::syscall(__NR_io_uring_enter, _fd, to_submit, wait_for, flags, arg, arg_size);
+            if (r >= 0) _sqe_submitted += static_cast<unsigned>(r);
+            return r;
+        }
+
+        void* _map(const size_t bytes, const unsigned long long offset) const
+        {
+            void* ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, _fd, static_cast<off_t>(offset));
+            return ptr == MAP_FAILED ? nullptr : ptr;
+        }
+
+        void _release()
+        {
+            if (_sqes != nullptr) ::munmap(_sqes, _sqes_bytes);
+            if (_cq_ptr != nullptr && _cq_ptr != _sq_ptr) ::munmap(_cq_ptr, _cq_bytes);
+            if (_sq_ptr != nullptr) ::munmap(_sq_ptr, _sq_bytes);
+            if (_fd != -1) ::close(_fd);
+
+            _sqes = nullptr;
+            _cq_ptr = nullptr;
+            _sq_ptr = nullptr;
+            _fd = -1;
+        }
+    };
+}
+
+#endif // BANKER_PLATFORM_LINUX
+
+#endif //BANKER_URING_HPP
@@ -16,6 +16,8 @@
 
 namespace banker::networker
 {
+    /// @brief stateless packet encryption with caller managed nonces.
+    /// @note every call re-derives the XChaCha20 subkey, for a connection use crypto_session.
     class crypto_core
     {
     public:
@@ -29,7 +31,7 @@ namespace banker::networker
         crypto_core& operator=(crypto_core&&)       = default;
 
         BANKER_NODISCARD static crypter::mac encrypt_packet(
-            packet& packet,
+            packet& pkt,
             const crypter::key& shared_key,
             const crypter::nonce& nonce,
             const std::span<uint8_t> extra_data = {})
@@ -37,7 +39,7 @@ namespace banker::networker
             crypter::mac result;
             crypter::encrypt(
                 shared_key,
-                packet.get_remaining_data(),
+                pkt.get_remaining_data(),
                 extra_data,
                 nonce,
                 result);
@@ -46,7 +48,7 @@ namespace banker::networker
         }
 
         bool static decrypt_packet(
-            packet& packet,
+            packet& pkt,
             const crypter::key& shared_key,
             const crypter::nonce& nonce,
             const crypter::mac& hmac,
@@ -54,7 +56,7 @@ namespace banker::networker
         {
             return crypter::decrypt(
                 shared_key,
-                packet.get_remaining_data(),
+                pkt.get_remaining_data(),
                 extra_data,
                 nonce,
                 hmac);
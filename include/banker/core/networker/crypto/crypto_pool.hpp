@@ -0,0 +1,305 @@
+/* ================================== *\
+ @file     crypto_pool.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_CRYPTO_POOL_HPP
+#define BANKER_CRYPTO_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "banker/core/crypto/crypter.hpp"
+#include "banker/core/networker/crypto/crypto_session.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::networker
+{
+    /// @brief runs batches of encrypt / decrypt jobs across a fixed set of worker threads.
+    /// @details the calling thread submits a batch and works along until it is done, so a pool
+    /// with 0 workers simply runs everything on the caller. jobs on the same crypto_session run
+    /// one after the other in submission order (sessions ratchet), everything else runs in any order.
+    /// @code{.cpp}
+    /// std::vector<crypto_pool::job> jobs;
+    /// for (auto& frame : frames) jobs.push_back(crypto_pool::job::open(frame.session, frame.bytes, frame.mac));
+    /// pool.run(jobs);
+    /// for (auto& j : jobs) if (!j.ok) drop(j);
+    /// @endcode
+    class crypto_pool
+    {
+    public:
+        enum class operation : uint8_t
+        {
+            encrypt,
+            decrypt
+        };
+
+        /// @brief one encryption or decryption, done in place on 'data'.
+        /// @details uses 'session' when set, the key and nonce otherwise.
+        struct job
+        {
+            operation op{operation::encrypt};
+            std::span<uint8_t> data{};
+            std::span<const uint8_t> extra_data{};
+
+            crypto_session* session{nullptr};
+            const crypter::key* key{nullptr};
+            crypter::nonce nonce{};
+
+            /// @brief out for encrypt, in for decrypt.
+            crypter::mac mac{};
+
+            /// @brief set after the run, false -> decryption failed (or the session was broken).
+            bool ok{false};
+
+            static job seal(
+                const crypter::key& key,
+                const crypter::nonce& nonce,
+                const std::span<uint8_t> data,
+                const std::span<const uint8_t> extra_data = {})
+            {
+                job j{};
+                j.op = operation::encrypt;
+                j.key = &key;
+                j.nonce = nonce;
+                j.data = data;
+                j.extra_data = extra_data;
+                return j;
+            }
+
+            static job open(
+                const crypter::key& key,
+                const crypter::nonce& nonce,
+                const std::span<uint8_t> data,
+                const crypter::mac& mac,
+                const std::span<const uint8_t> extra_data = {})
+            {
+                job j = seal(key, nonce, data, extra_data);
+                j.op = operation::decrypt;
+                j.mac = mac;
+                return j;
+            }
+
+            static job seal(
+                crypto_session& session,
+                const std::span<uint8_t> data,
+                const std::span<const uint8_t> extra_data = {})
+            {
+                job j{};
+                j.op = operation::encrypt;
+                j.session = &session;
+                j.data = data;
+                j.extra_data = extra_data;
+                return j;
+            }
+
+            static job open(
+                crypto_session& session,
+                const std::span<uint8_t> data,
+                const crypter::mac& mac,
+                const std::span<const uint8_t> extra_data = {})
+            {
+                job j = seal(session, data, extra_data);
+                j.op = operation::decrypt;
+                j.mac = mac;
+                return j;
+            }
+        };
+
+        /// @brief batches with fewer bytes than this run on the caller, waking workers costs more.
+        static constexpr size_t min_parallel_bytes = 1024 * 16;
+
+    public:
+        /// @param worker_count threads besides the caller, 0 -> hardware threads - 1.
+        explicit crypto_pool(size_t worker_count = 0)
+        {
+            if (worker_count == 0) worker_count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+            _workers.reserve(worker_count);
+            for (size_t i = 0; i < worker_count; ++i)
+                _workers.emplace_back([this] { _worker_loop(); });
+        }
+
+        ~crypto_pool()
+        {
+            {
+                std::lock_guard lock(_mutex);
+                _stop = true;
+            }
+            _work_cv.notify_all();
+
+            for (auto& t : _workers)
+                if (t.joinable()) t.join();
+        }
+
+        crypto_pool(const crypto_pool&)             = delete;
+        crypto_pool& operator=(const crypto_pool&)  = delete;
+
+        crypto_pool(crypto_pool&&)                  = delete;
+        crypto_pool& operator=(crypto_pool&&)       = delete;
+
+        /// @brief runs every job, returns when all are done.
+        /// @param jobs must stay alive (and unmoved) until run() returns.
+        void run(const std::span<job> jobs)
+        {
+            if (jobs.empty()) return;
+
+            size_t bytes = 0;
+            for (const job& j : jobs) bytes += j.data.size();
+
+            if (_workers.empty() || bytes < min_parallel_bytes)
+            {
+                for (job& j : jobs) _execute(j);
+                return;
+            }
+
+            _build_chains(jobs);
+
+            {
+                std::lock_guard lock(_mutex);
+                _jobs = jobs;
+                _cursor.store(0, std::memory_order_relaxed);
+                _done = 0;
+                _open = true;
+                ++_generation;
+            }
+            _work_cv.notify_all();
+
+            _work();
+
+            std::unique_lock lock(_mutex);
+            _done_cv.wait(lock, [this] { return _done == _heads.size() && _active == 0; });
+            _jobs = {};
+        }
+
+        BANKER_NODISCARD size_t worker_count() const { return _workers.size(); }
+
+    private:
+        static constexpr size_t _end = static_cast<size_t>(-1);
+
+        std::vector<std::thread>    _workers{};
+        std::mutex                  _mutex{};
+        std::condition_variable     _work_cv{};
+        std::condition_variable     _done_cv{};
+
+        std::span<job>              _jobs{};
+        std::vector<size_t>         _heads{};
+        std::vector<size_t>         _next{};
+        std::unordered_map<crypto_session*, size_t> _session_tail{};
+
+        std::atomic<size_t>         _cursor{0};
+        size_t                      _done{0};
+        size_t                      _active{0};
+        uint64_t                    _generation{0};
+        bool                        _open{false};
+        bool                        _stop{false};
+
+        /// @brief links jobs into chains, one per session (in order) and one per sessionless job.
+        void _build_chains(const std::span<job> jobs)
+        {
+            _heads.clear();
+            _next.assign(jobs.size(), _end);
+            _session_tail.clear();
+
+            for (size_t i = 0; i < jobs.size(); ++i)
+            {
+                if (jobs[i].session != nullptr)
+                {
+                    const auto [it, inserted] = _session_tail.try_emplace(jobs[i].session, i);
+                    if (!inserted)
+                    {
+                        _next[it->second] = i;
+                        it->second = i;
+                        continue;
+                    }
+                }
+                _heads.push_back(i);
+            }
+        }
+
+        /// @brief takes chains until none are left.
+        void _work()
+        {
+            size_t finished = 0;
+            for (size_t c = _cursor.fetch_add(1, std::memory_order_relaxed);
+                 c < _heads.size();
+                 c = _cursor.fetch_add(1, std::memory_order_relaxed))
+            {
+                for (size_t i = _heads[c]; i != _end; i = _next[i]) _execute(_jobs[i]);
+                ++finished;
+            }
+
+            if (finished == 0) return;
+
+            std::lock_guard lock(_mutex);
+            _done += finished;
+            if (_done == _heads.size())
+            {
+                // late workers must not touch the chains anymore, the next run rebuilds them.
+                _open = false;
+                _done_cv.notify_all();
+            }
+        }
+
+        void _worker_loop()
+        {
+            uint64_t seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock lock(_mutex);
+                    _work_cv.wait(lock, [&] { return _stop || _generation != seen; });
+                    if (_stop) return;
+
+                    seen = _generation;
+                    if (!_open) continue;
+                    ++_active;
+                }
+
+                _work();
+
+                std::lock_guard lock(_mutex);
+                if (--_active == 0) _done_cv.notify_all();
+            }
+        }
+
+        static void _execute(job& j)
+        {
+            if (j.session != nullptr)
+            {
+                if (j.op == operation::encrypt)
+                {
+                    const auto mac = j.session->seal(j.data, j.extra_data);
+                    j.ok = mac.has_value();
+                    if (mac) j.mac = *mac;
+                }
+                else
+                {
+                    j.ok = j.session->open(j.data, j.mac, j.extra_data);
+                }
+                return;
+            }
+
+            if (j.op == operation::encrypt)
+            {
+                crypter::encrypt(*j.key, j.data, j.extra_data, j.nonce, j.mac);
+                j.ok = true;
+            }
+            else
+            {
+                j.ok = crypter::decrypt(*j.key, j.data, j.extra_data, j.nonce, j.mac);
+            }
+        }
+    };
+}
+
+#endif //BANKER_CRYPTO_POOL_HPP
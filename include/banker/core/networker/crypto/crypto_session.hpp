@@ -0,0 +1,205 @@
+/* ================================== *\
+ @file     crypto_session.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_CRYPTO_SESSION_HPP
+#define BANKER_CRYPTO_SESSION_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "banker/core/crypto/crypter.hpp"
+#include "banker/core/networker/core/packet/packet.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::networker
+{
+    /// @brief the encryption state of one connection, a send and a receive crypto_aead_ctx.
+    /// @details the XChaCha20 subkey is derived once when the session is made, after that every
+    /// message ratchets the key forward (crypto_aead_write / crypto_aead_read), so there are no
+    /// per message nonces to get wrong. messages must be opened in the order they were sealed.
+    /// both sides build the session from the same shared key with opposite roles:
+    /// @code{.cpp}
+    /// crypto_session client{shared, crypto_session::role::initiator};
+    /// crypto_session server{shared, crypto_session::role::responder};
+    ///
+    /// const auto mac = client.seal(bytes);
+    /// if (!mac || !server.open(bytes, *mac)) drop_connection();
+    /// @endcode
+    /// @warning the shared key must be unique to the session (a fresh handshake), the same key with
+    /// the same role always produces the same key stream.
+    class crypto_session
+    {
+    public:
+        /// @brief which end of the connection this is, picks the direction of the two streams.
+        enum class role : uint8_t
+        {
+            initiator,
+            responder
+        };
+
+    public:
+        crypto_session()    = default;
+        ~crypto_session()   { _wipe(); }
+
+        crypto_session(const crypto_session&)             = delete;
+        crypto_session& operator=(const crypto_session&)  = delete;
+
+        crypto_session(crypto_session&& other) noexcept
+        {
+            _take(other);
+        }
+
+        crypto_session& operator=(crypto_session&& other) noexcept
+        {
+            if (this == &other) return *this;
+            _wipe();
+            _take(other);
+            return *this;
+        }
+
+        /// @param shared_key the key both sides agreed on (crypter::handshake::get_shared_secret()).
+        /// @param r this side's role, the other side uses the opposite one.
+        crypto_session(const crypter::key& shared_key, const role r)
+        {
+            const crypter::nonce forward = _direction_nonce(1);
+            const crypter::nonce backward = _direction_nonce(2);
+
+            const bool initiator = r == role::initiator;
+            crypto_aead_init_x(&_send, shared_key.bytes, (initiator ? forward : backward).bytes);
+            crypto_aead_init_x(&_receive, shared_key.bytes, (initiator ? backward : forward).bytes);
+            _valid = true;
+        }
+
+        /// @brief encrypts 'data' in place.
+        /// @param data plaintext, becomes the cipher text.
+        /// @param extra_data authenticated but not encrypted (headers ...).
+        /// @return the mac to send along, nothing (data untouched) if the session isn't valid.
+        BANKER_NODISCARD std::optional<crypter::mac> seal(
+            const std::span<uint8_t> data,
+            const std::span<const uint8_t> extra_data = {})
+        {
+            return seal_to(data.data(), data, extra_data);
+        }
+
+        /// @brief encrypts 'plain' into 'out', so the cipher text can be written straight
+        /// where it will be sent.
+        /// @param out at least plain.size() bytes, may be plain.data().
+        /// @return the mac to send along, nothing (out untouched) if the session isn't valid.
+        /// @note a default constructed, moved from or broken session has a wiped key, it never seals.
+        BANKER_NODISCARD std::optional<crypter::mac> seal_to(
+            uint8_t* out,
+            const std::span<const uint8_t> plain,
+            const std::span<const uint8_t> extra_data = {})
+        {
+            if (!_valid) return std::nullopt;
+
+            crypter::mac result{};
+            crypto_aead_write(
+                &_send,
+                out,
+                result.bytes,
+                extra_data.data(), extra_data.size(),
+                plain.data(), plain.size());
+
+            ++_sealed;
+            return result;
+        }
+
+        /// @brief decrypts 'data' in place.
+        /// @param data cipher text, becomes the plaintext on success (untouched on failure).
+        /// @param mac the mac that came with it.
+        /// @param extra_data the same extra data that was passed to seal().
+        /// @return true -> authentic, false -> forged, out of order or the session is broken.
+        /// @note a failed open breaks the session for good, on a stream nothing after it can be trusted.
+        BANKER_NODISCARD bool open(
+            const std::span<uint8_t> data,
+            const crypter::mac& mac,
+            const std::span<const uint8_t> extra_data = {})
+        {
+            if (!_valid) return false;
+
+            const int r = crypto_aead_read(
+                &_receive,
+                data.data(),
+                mac.bytes,
+                extra_data.data(), extra_data.size(),
+                data.data(), data.size());
+
+            if (r != 0)
+            {
+                _wipe();
+                return false;
+            }
+
+            ++_opened;
+            return true;
+        }
+
+        /// @brief encrypts the unread part of the packet in place.
+        /// @return see seal().
+        template<typename Allocator>
+        BANKER_NODISCARD std::optional<crypter::mac> seal_packet(
+            basic_packet<Allocator>& pkt,
+            const std::span<const uint8_t> extra_data = {})
+        {
+            return seal(pkt.get_remaining_data(), extra_data);
+        }
+
+        /// @brief decrypts the unread part of the packet in place.
+        template<typename Allocator>
+        BANKER_NODISCARD bool open_packet(
+            basic_packet<Allocator>& pkt,
+            const crypter::mac& mac,
+            const std::span<const uint8_t> extra_data = {})
+        {
+            return open(pkt.get_remaining_data(), mac, extra_data);
+        }
+
+        /// @brief false when default constructed, moved from or after a failed open().
+        BANKER_NODISCARD bool is_valid() const { return _valid; }
+
+        /// @brief messages sealed so far.
+        BANKER_NODISCARD uint64_t sealed() const { return _sealed; }
+
+        /// @brief messages opened so far.
+        BANKER_NODISCARD uint64_t opened() const { return _opened; }
+
+    private:
+        crypto_aead_ctx _send{};
+        crypto_aead_ctx _receive{};
+        uint64_t _sealed{0};
+        uint64_t _opened{0};
+        bool _valid{false};
+
+        static crypter::nonce _direction_nonce(const uint8_t direction)
+        {
+            crypter::nonce n{};
+            n.bytes[0] = direction;
+            return n;
+        }
+
+        void _take(crypto_session& other)
+        {
+            _send = other._send;
+            _receive = other._receive;
+            _sealed = other._sealed;
+            _opened = other._opened;
+            _valid = other._valid;
+            other._wipe();
+        }
+
+        void _wipe()
+        {
+            crypto_wipe(&_send, sizeof(_send));
+            crypto_wipe(&_receive, sizeof(_receive));
+            _valid = false;
+        }
+    };
+}
+
+#endif //BANKER_CRYPTO_SESSION_HPP
@@ -0,0 +1,163 @@
+/* ================================== *\
+ @file     crypto_stream_core.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_CRYPTO_STREAM_CORE_HPP
+#define BANKER_CRYPTO_STREAM_CORE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "banker/common/containers/buffer_pool.hpp"
+#include "banker/core/networker/core/packet/packet.hpp"
+#include "banker/core/networker/core/stream_socket/stream_receive_buffer.hpp"
+#include "banker/core/networker/core/stream_socket/stream_socket_core.hpp"
+#include "banker/core/networker/crypto/crypto_session.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::networker
+{
+    /// @brief encrypted framing on top of stream_socket_core.
+    /// @details a frame is [length (4 bytes, big endian)][mac (16 bytes)][cipher text], the length
+    /// counts the mac and the cipher text. the length bytes are authenticated as extra data, so a
+    /// frame can't be cut or stretched without open_sealed() noticing.
+    /// the payload is encrypted exactly where it is sent from, no serialization copies are made.
+    class crypto_stream_core
+    {
+    public:
+        static constexpr size_t header_size = sizeof(uint32_t);
+        static constexpr size_t mac_size = sizeof(crypter::mac);
+
+        /// @brief bytes a frame adds to its payload.
+        static constexpr size_t overhead = header_size + mac_size;
+
+        enum class open_result : uint8_t
+        {
+            /// @brief no complete frame buffered yet.
+            incomplete,
+
+            /// @brief a frame was decrypted.
+            ok,
+
+            /// @brief the frame is malformed or failed authentication, drop the connection.
+            forged
+        };
+
+    public:
+        /// @brief encrypts the packet's payload in place and queues it behind an inline header + mac.
+        /// @param pkt the packet, left empty (unless nothing was queued).
+        /// @return rejected without a valid session (never set, or broken by a forged frame),
+        /// overflow where the policy is drop_oldest (queued sealed frames are never dropped).
+        /// @note the session and the limits are checked before sealing, a refused frame doesn't use up a nonce.
+        template<typename Allocator>
+        static stream_socket_core::enqueue_result enqueue_sealed(
+            stream_socket_core::send_state& state,
+            crypto_session& session,
+            basic_packet<Allocator>&& pkt)
+        {
+            if (!session.is_valid()) return stream_socket_core::enqueue_result::rejected;
+
+            const auto admitted = _admit(state, overhead + pkt.get_data().size());
+            if (!stream_socket_core::was_queued(admitted)) return admitted;
+
+            auto body = pkt.release();
+
+            uint8_t prefix[overhead];
+            _write_header(prefix, body.size());
+
+            const auto mac = session.seal({body.data(), body.size()}, {prefix, header_size});
+            if (!mac) return stream_socket_core::enqueue_result::rejected;
+            std::memcpy(prefix + header_size, mac->bytes, mac_size);
+
+            static_assert(overhead <= variant_buffer::inline_capacity, "header + mac must fit inline");
+            return stream_socket_core::push_frame(
+                state,
+                stream_transmit_buffer::inline_copy(prefix, overhead),
+                stream_transmit_buffer{std::move(body)});
+        }
+
+        /// @brief encrypts 'payload' straight into a pooled transmit buffer and queues it.
+        /// @return rejected without a valid session.
+        static stream_socket_core::enqueue_result enqueue_sealed(
+            stream_socket_core::send_state& state,
+            crypto_session& session,
+            const std::span<const uint8_t> payload)
+        {
+            if (!session.is_valid()) return stream_socket_core::enqueue_result::rejected;
+
+            const auto admitted = _admit(state, overhead + payload.size());
+            if (!stream_socket_core::was_queued(admitted)) return admitted;
+
+            pooled_bytes frame(overhead + payload.size());
+            _write_header(frame.data(), payload.size());
+
+            const auto mac = session.seal_to(frame.data() + overhead, payload, {frame.data(), header_size});
+            if (!mac) return stream_socket_core::enqueue_result::rejected;
+            std::memcpy(frame.data() + header_size, mac->bytes, mac_size);
+
+            return stream_socket_core::push_frame(state, stream_transmit_buffer{std::move(frame)});
+        }
+
+        /// @brief decrypts the next complete frame in place in the receive buffer.
+        /// @param payload set to the plaintext (inside the receive buffer) on ok.
+        /// @param frame_size set to the bytes the frame takes, consume() them once done with the payload.
+        static open_result open_sealed(
+            stream_receive_buffer& buffer,
+            crypto_session& session,
+            std::span<uint8_t>& payload,
+            size_t& frame_size)
+        {
+            uint8_t header[header_size];
+            if (!buffer.peek(header, header_size)) return open_result::incomplete;
+
+            const size_t size =
+                (static_cast<size_t>(header[0]) << 24) |
+                (static_cast<size_t>(header[1]) << 16) |
+                (static_cast<size_t>(header[2]) << 8)  |
+                 static_cast<size_t>(header[3]);
+
+            if (size < mac_size) return open_result::forged;
+            if (buffer.size() - header_size < size) return open_result::incomplete;
+
+            const auto bytes = buffer.contiguous().first(header_size + size);
+
+            crypter::mac mac{};
+            std::memcpy(mac.bytes, bytes.data() + header_size, mac_size);
+
+            const auto cipher = bytes.subspan(overhead);
+            if (!session.open(cipher, mac, bytes.first(header_size))) return open_result::forged;
+
+            payload = cipher;
+            frame_size = bytes.size();
+            return open_result::ok;
+        }
+
+    private:
+        /// @brief admit() that never drops queued frames: a dropped sealed frame leaves the peer's
+        /// receive ratchet behind ours and every later frame fails to open, so drop_oldest
+        /// overflows (disconnect) instead.
+        /// @note call once the session is known to be valid, so an admitted frame always gets sealed.
+        static stream_socket_core::enqueue_result _admit(
+            stream_socket_core::send_state& state,
+            const size_t bytes)
+        {
+            using policy = stream_socket_core::overflow_policy;
+            const policy p = state.limits.policy == policy::drop_oldest ? policy::disconnect : state.limits.policy;
+            return stream_socket_core::admit(state, bytes, p);
+        }
+        static void _write_header(uint8_t* out, const size_t payload_size)
+        {
+            const auto size = static_cast<uint32_t>(mac_size + payload_size);
+            out[0] = static_cast<uint8_t>(size >> 24);
+            out[1] = static_cast<uint8_t>(size >> 16);
+            out[2] = static_cast<uint8_t>(size >> 8);
+            out[3] = static_cast<uint8_t>(size);
+        }
+    };
+}
+
+#endif //BANKER_CRYPTO_STREAM_CORE_HPP
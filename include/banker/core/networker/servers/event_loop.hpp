@@ -0,0 +1,538 @@
+/* ================================== *\
+ @file     event_loop.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_EVENT_LOOP_HPP
+#define BANKER_EVENT_LOOP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "banker/common/time/timer_wheel.hpp"
+#include "banker/core/networker/client_containers/stable_storage.hpp"
+#include "banker/core/networker/core/socket/error.hpp"
+#include "banker/core/networker/core/socket/polling.hpp"
+#include "banker/core/networker/core/stream_socket/stream_socket.hpp"
+#include "banker/core/networker/core/stream_socket/stream_socket_core.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::networker
+{
+    /// @brief single threaded tcp event loop: an optional listener, a poll_group and the connections.
+    /// @details only sockets the poller reports ready are ticked, writes queued during a round are
+    /// flushed at its end and write readiness is only asked for while the OS is full. the poll waits
+    /// until the next timer (connection timeouts, schedule()) is due, so an idle loop sleeps in the kernel.
+    /// callbacks run on the thread that runs the loop.
+    /// @code{.cpp}
+    /// event_loop loop{};
+    /// event_loop::callbacks cbs{};
+    /// cbs.on_receive = [](event_loop& l, stable_id id) { stream_socket* client = l.get(id); ... };
+    /// loop.set_callbacks(std::move(cbs));
+    /// if (loop.listen("0.0.0.0", 8080)) loop.run();
+    /// @endcode
+    class event_loop
+    {
+    public:
+        /// @brief per connection timeouts, 0 -> off.
+        struct timeouts
+        {
+            /// @brief nothing received and nothing sent for this long.
+            std::chrono::milliseconds   idle{0};
+
+            /// @brief nothing received for this long.
+            std::chrono::milliseconds   read{0};
+
+            /// @brief queued data made no progress for this long (a reader that stopped reading).
+            std::chrono::milliseconds   write{0};
+        };
+
+        enum class timeout_kind : uint8_t
+        {
+            idle,
+            read,
+            write
+        };
+
+        struct callbacks
+        {
+            /// @brief a new connection got accepted (or adopted).
+            std::function<void(event_loop&, stable_id)>                 on_connect{};
+
+            /// @brief new data got appended to get(id)->receive().
+            std::function<void(event_loop&, stable_id)>                 on_receive{};
+
+            /// @brief the connection is about to be removed.
+            std::function<void(event_loop&, stable_id)>                 on_disconnect{};
+
+            /// @brief the send queue crossed the high watermark (true) or drained to the low one (false).
+            std::function<void(event_loop&, stable_id, bool paused)>    on_send_pressure{};
+
+            /// @brief a connection timed out, it is disconnected right after.
+            std::function<void(event_loop&, stable_id, timeout_kind)>   on_timeout{};
+
+            /// @brief a timer from schedule() expired.
+            std::function<void(event_loop&, uint64_t user_data)>        on_timer{};
+        };
+
+    public:
+        /// @param index a number for the owner (sharded_stream_server's worker index).
+        explicit event_loop(const size_t index = 0) : _index(index) {}
+        ~event_loop() = default;
+
+        event_loop(const event_loop&)               = delete;
+        event_loop& operator=(const event_loop&)    = delete;
+
+        event_loop(event_loop&&)                    = delete;
+        event_loop& operator=(event_loop&&)         = delete;
+
+        void set_callbacks(callbacks cbs) { _callbacks = std::move(cbs); }
+
+        /// @brief send queue limits new connections get.
+        void set_send_limits(const stream_socket::send_limits& limits) { _send_limits = limits; }
+
+        /// @brief timeouts new connections get.
+        void set_timeouts(const timeouts& t) { _timeouts = t; }
+
+        /// @brief opens the listener, accepted connections join the loop.
+        /// @param port 0 picks one (see port()).
+        /// @return false -> the listener couldn't be created.
+        bool listen(
+            const std::string& ip,
+            const uint16_t port,
+            const int backlog = 1024,
+            const bool reuse_port = false)
+        {
+            socket listener = stream_socket_core::new_server_socket(ip, port, backlog, reuse_port);
+            if (!listener.is_valid() || !_poller.add(listener, poll_group::interest::read, _listener_tag))
+                return false;
+
+            if (_listener.is_valid()) _poller.remove(_listener);
+            _listener = std::move(listener);
+            _accept_paused = false;
+            return true;
+        }
+
+        /// @brief the port the listener is bound to, 0 without one.
+        BANKER_NODISCARD uint16_t port() const
+        {
+            return _listener.is_valid() ? _listener.get_local_info().port : 0;
+        }
+
+        /// @brief adds an already connected socket (an outgoing connection) to the loop.
+        /// @return its id, invalid_id -> the socket is invalid or couldn't be registered.
+        stable_id adopt(stream_socket&& client)
+        {
+            if (!client.is_valid()) return invalid_id;
+            _now = clock::now();
+            return _add(std::move(client));
+        }
+
+        /// @brief one round: waits for readiness (or the next timer), ticks the ready sockets,
+        /// fires due timers and flushes what got queued.
+        /// @param max_wait_ms upper bound on the wait, -1 -> until something happens.
+        /// @return amount of ready sockets handled.
+        size_t run_once(const int max_wait_ms = -1)
+        {
+            _now = clock::now();
+            const int timeout = _merge_timeouts(
+                _merge_timeouts(_deadlines.poll_timeout(_now, max_wait_ms), _timers.poll_timeout(_now, max_wait_ms)),
+                _accept_timeout());
+
+            const int ready = _poller.poll(timeout);
+            _now = clock::now();
+            if (_accept_paused && _now >= _accept_resume) _resume_accept();
+
+            size_t handled = 0;
+            poll_group::result r;
+            while (ready > 0 && _poller.next_result(r) != -1)
+            {
+                ++handled;
+                if (r.user_data == _listener_tag)
+                {
+                    _accept_all();
+                    continue;
+                }
+
+                const stable_id id = r.user_data;
+                connection* c = _clients.get(id);
+                if (c == nullptr) continue;
+
+                tcp::request_result result;
+                const size_t received = _tick(
+                    *c,
+                    r.readable || r.disconnected || r.error,
+                    r.writable,
+                    result);
+
+                if (result != tcp::request_result::ok)
+                {
+                    disconnect(id);
+                    continue;
+                }
+
+                if (received > 0 && _callbacks.on_receive)
+                    _callbacks.on_receive(*this, id);
+
+                _dirty.push_back(id);
+            }
+
+            _expire();
+            _flush_dirty();
+            return handled;
+        }
+
+        /// @brief runs until stop() is called (from a callback).
+        void run()
+        {
+            _stopping = false;
+            while (!_stopping) run_once(-1);
+        }
+
+        /// @brief runs while 'running' is set, another thread can clear it.
+        /// @param check_ms how often 'running' is looked at while idle.
+        void run(const std::atomic<bool>& running, const int check_ms = 100)
+        {
+            _stopping = false;
+            while (!_stopping && running.load(std::memory_order_relaxed)) run_once(check_ms);
+        }
+
+        /// @brief makes run() return after the current round.
+        /// @warning only call from the loop's thread (from inside a callback).
+        void stop() { _stopping = true; }
+
+        BANKER_NODISCARD size_t index() const { return _index; }
+
+        /// @brief amount of connections in the loop.
+        BANKER_NODISCARD size_t connection_count() const { return _clients.size(); }
+
+        /// @brief a connection of this loop, or nullptr.
+        /// @warning adopt() and disconnect() move connections around, get() it again after calling them.
+        BANKER_NODISCARD stream_socket* get(const stable_id id)
+        {
+            connection* c = _clients.get(id);
+            return c != nullptr ? &c->socket : nullptr;
+        }
+
+        /// @brief queues data for a connection, written as soon as the socket allows.
+        /// @return see stream_socket::enqueue_result, an overflowed connection is dropped after this round.
+        /// @warning only call from the loop's thread (from inside a callback).
+        stream_socket::enqueue_result send(const stable_id id, std::vector<uint8_t>&& data)
+        {
+            connection* c = _clients.get(id);
+            if (c == nullptr) return stream_socket::enqueue_result::rejected;
+            _before_send(*c);
+            return _after_send(id, *c, c->socket.enqueue(std::move(data)));
+        }
+
+        /// @brief queues a shared payload for a connection, no copy is made.
+        /// @warning only call from the loop's thread (from inside a callback).
+        stream_socket::enqueue_result send(const stable_id id, shared_bytes data)
+        {
+            connection* c = _clients.get(id);
+            if (c == nullptr) return stream_socket::enqueue_result::rejected;
+            _before_send(*c);
+            return _after_send(id, *c, c->socket.enqueue(std::move(data)));
+        }
+
+        /// @brief disconnects a connection (on_disconnect is called).
+        /// @warning only call from the loop's thread (from inside a callback).
+        void disconnect(const stable_id id)
+        {
+            connection* c = _clients.get(id);
+            if (c == nullptr) return;
+
+            if (_callbacks.on_disconnect) _callbacks.on_disconnect(*this, id);
+
+            // look it up again, the callback may have sent (or disconnected) on it.
+            c = _clients.get(id);
+            if (c == nullptr) return;
+
+            _deadlines.cancel(c->deadline);
+            _poller.remove(c->socket.raw_socket());
+            _clients.remove(id);
+        }
+
+        /// @brief calls on_timer(user_data) on this loop after 'delay' (heartbeats, retries ...).
+        /// @warning only call from the loop's thread (from inside a callback).
+        time::timer_id schedule(const std::chrono::milliseconds delay, const uint64_t user_data)
+        {
+            return _timers.schedule(delay, user_data, _now);
+        }
+
+        /// @return false -> it already fired or was cancelled.
+        /// @warning only call from the loop's thread (from inside a callback).
+        bool cancel(const time::timer_id id)
+        {
+            return _timers.cancel(id);
+        }
+
+    private:
+        using clock = time::timer_wheel::clock;
+
+        struct connection
+        {
+            stream_socket       socket{};
+            bool                want_write{false};
+
+            /// @brief last pause state reported through on_send_pressure.
+            bool                paused{false};
+
+            /// @brief the earliest timeout, checked (and moved on) when it fires.
+            time::timer_id      deadline{time::invalid_timer};
+            clock::time_point   last_read{};
+
+            /// @brief the send queue last made progress (or went from empty to non empty).
+            clock::time_point   last_write{};
+        };
+
+        static constexpr uint64_t _listener_tag = invalid_id;
+        static constexpr auto _timer_resolution = std::chrono::milliseconds(10);
+
+        /// @brief how long the listener is left alone after accept() ran out of descriptors.
+        static constexpr auto _accept_backoff = std::chrono::milliseconds(100);
+
+        size_t                              _index{0};
+        socket                              _listener{};
+        poll_group                          _poller{};
+        stable_storage<connection>          _clients{};
+        std::vector<stable_id>              _dirty{};
+        callbacks                           _callbacks{};
+        stream_socket::send_limits          _send_limits{};
+        timeouts                            _timeouts{};
+        bool                                _stopping{false};
+
+        clock::time_point                   _now{clock::now()};
+
+        /// @brief the listener is out of the poller until _accept_resume.
+        bool                                _accept_paused{false};
+        clock::time_point                   _accept_resume{};
+
+        /// @brief connection deadlines, user_data is the connection id.
+        time::timer_wheel                   _deadlines{_timer_resolution};
+
+        /// @brief schedule() timers.
+        time::timer_wheel                   _timers{_timer_resolution};
+
+        /// @brief the shorter of two poll timeouts, -1 meaning forever.
+        static int _merge_timeouts(const int a, const int b)
+        {
+            if (a < 0) return b;
+            if (b < 0) return a;
+            return std::min(a, b);
+        }
+
+        void _before_send(connection& c) const
+        {
+            // the write timeout counts from when data starts waiting.
+            if (!c.socket.has_pending_send()) c.last_write = _now;
+        }
+
+        stream_socket::enqueue_result _after_send(
+            const stable_id id,
+            connection& c,
+            const stream_socket::enqueue_result result)
+        {
+            _dirty.push_back(id);
+            _report_pressure(id, c);
+            return result;
+        }
+
+        void _report_pressure(const stable_id id, connection& c)
+        {
+            const bool paused = c.socket.is_send_paused();
+            if (paused == c.paused) return;
+
+            c.paused = paused;
+            if (_callbacks.on_send_pressure) _callbacks.on_send_pressure(*this, id, paused);
+        }
+
+        /// @brief socket tick that keeps the timeout timestamps up to date.
+        size_t _tick(
+            connection& c,
+            const bool readable,
+            const bool writable,
+            tcp::request_result& result)
+        {
+            const size_t queued = c.socket.queued_bytes();
+            const size_t received = c.socket.tick(readable, writable, &result);
+
+            if (received > 0) c.last_read = _now;
+            if (c.socket.queued_bytes() < queued) c.last_write = _now;
+            return received;
+        }
+
+        /// @brief fires due timers and timeouts.
+        void _expire()
+        {
+            _timers.advance(_now, [this](time::timer_id, const uint64_t user_data)
+            {
+                if (_callbacks.on_timer) _callbacks.on_timer(*this, user_data);
+            });
+
+            _deadlines.advance(_now, [this](time::timer_id, const uint64_t user_data)
+            {
+                const stable_id id = user_data;
+                connection* c = _clients.get(id);
+                if (c == nullptr) return;
+
+                c->deadline = time::invalid_timer;
+                timeout_kind kind;
+                if (!_expired(*c, kind))
+                {
+                    _arm(id, *c);
+                    return;
+                }
+
+                if (_callbacks.on_timeout) _callbacks.on_timeout(*this, id, kind);
+                disconnect(id);
+            });
+        }
+
+        /// @return true -> a timeout passed, 'kind' says which.
+        bool _expired(const connection& c, timeout_kind& kind) const
+        {
+            const timeouts& t = _timeouts;
+            const auto passed = [this](const clock::time_point since, const std::chrono::milliseconds limit)
+            {
+                return limit.count() > 0 && _now - since >= limit;
+            };
+
+            if (passed(std::max(c.last_read, c.last_write), t.idle))    { kind = timeout_kind::idle;  return true; }
+            if (passed(c.last_read, t.read))                            { kind = timeout_kind::read;  return true; }
+            if (c.socket.has_pending_send() && passed(c.last_write, t.write))
+                                                                        { kind = timeout_kind::write; return true; }
+            return false;
+        }
+
+        /// @brief schedules the connection's earliest deadline. activity only moves the timestamps,
+        /// the deadline is checked and moved on when it fires, so reads and writes never touch the wheel.
+        void _arm(const stable_id id, connection& c)
+        {
+            const timeouts& t = _timeouts;
+            auto next = clock::time_point::max();
+
+            if (t.idle.count() > 0)     next = std::min(next, std::max(c.last_read, c.last_write) + t.idle);
+            if (t.read.count() > 0)     next = std::min(next, c.last_read + t.read);
+            // nothing queued -> look again after one write timeout, data queued by then is checked then.
+            if (t.write.count() > 0)
+                next = std::min(next, (c.socket.has_pending_send() ? c.last_write : _now) + t.write);
+            if (next == clock::time_point::max()) return;
+
+            c.deadline = _deadlines.schedule(std::max(next - _now, clock::duration::zero()), id, _now);
+        }
+
+        stable_id _add(stream_socket&& client)
+        {
+            connection fresh{};
+            fresh.socket = std::move(client);
+            fresh.last_read = _now;
+            fresh.last_write = _now;
+
+            const stable_id id = _clients.add(std::move(fresh));
+            connection* c = _clients.get(id);
+            c->socket.set_send_limits(_send_limits);
+            if (!_poller.add(c->socket.raw_socket(), poll_group::interest::read, id))
+            {
+                _clients.remove(id);
+                return invalid_id;
+            }
+
+            _arm(id, *c);
+            if (_callbacks.on_connect) _callbacks.on_connect(*this, id);
+            _dirty.push_back(id);
+            return id;
+        }
+
+        void _accept_all()
+        {
+            while (true)
+            {
+                socket s = stream_socket_core::new_accepted_socket(_listener);
+                if (!s.is_valid())
+                {
+                    // the pending connection stays queued, so the listener stays readable: stop
+                    // watching it for a while instead of waking up for it every round.
+                    if (get_last_socket_error() == socket_error_code::no_resources) _pause_accept();
+                    return;
+                }
+
+                (void)_add(stream_socket{std::move(s)});
+            }
+        }
+
+        void _pause_accept()
+        {
+            _poller.remove(_listener);
+            _accept_paused = true;
+            _accept_resume = _now + _accept_backoff;
+        }
+
+        void _resume_accept()
+        {
+            _accept_paused = false;
+            if (!_poller.add(_listener, poll_group::interest::read, _listener_tag)) _pause_accept();
+        }
+
+        /// @brief ms until the listener is watched again, -1 -> it isn't paused.
+        BANKER_NODISCARD int _accept_timeout() const
+        {
+            if (!_accept_paused) return -1;
+            if (_now >= _accept_resume) return 0;
+            // rounded up, waking a bit early would just poll again.
+            const auto left = std::chrono::ceil<std::chrono::milliseconds>(_accept_resume - _now);
+            return static_cast<int>(left.count());
+        }
+
+        /// @brief writes what got queued this round and only asks for write readiness if the OS is full.
+        void _flush_dirty()
+        {
+            for (size_t i = 0; i < _dirty.size(); ++i)
+            {
+                const stable_id id = _dirty[i];
+                connection* c = _clients.get(id);
+                if (c == nullptr) continue;
+
+                if (c->socket.has_pending_send())
+                {
+                    tcp::request_result result;
+                    _tick(*c, false, true, result);
+                    if (result != tcp::request_result::ok)
+                    {
+                        disconnect(id);
+                        continue;
+                    }
+                }
+
+                if (c->socket.send_overflowed())
+                {
+                    disconnect(id);
+                    continue;
+                }
+
+                const bool want_write = c->socket.has_pending_send();
+                if (want_write != c->want_write)
+                {
+                    c->want_write = want_write;
+                    _poller.modify(
+                        c->socket.raw_socket(),
+                        want_write ? poll_group::interest::both : poll_group::interest::read,
+                        id);
+                }
+
+                // last, the callback may send (growing _dirty) or disconnect.
+                _report_pressure(id, *c);
+            }
+            _dirty.clear();
+        }
+    };
+}
+
+#endif //BANKER_EVENT_LOOP_HPP
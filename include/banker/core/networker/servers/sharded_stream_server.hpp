@@ -0,0 +1,130 @@
+/* ================================== *\
+ @file     sharded_stream_server.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_SHARDED_STREAM_SERVER_HPP
+#define BANKER_SHARDED_STREAM_SERVER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "banker/core/networker/core/stream_socket/stream_socket.hpp"
+#include "banker/core/networker/servers/event_loop.hpp"
+#include "banker/shared/compat.hpp"
+
+namespace banker::networker
+{
+    /// @brief thread-per-core tcp server, workers share nothing.
+    /// @details every worker is an event_loop with its own SO_REUSEPORT listener on the same port,
+    /// its own poll_group and its own connections, so the kernel spreads accepts over the workers
+    /// and no locks are needed. callbacks run on the worker thread that owns the connection.
+    /// @note without SO_REUSEPORT (windows) the server runs a single worker.
+    class sharded_stream_server
+    {
+    public:
+        using worker        = event_loop;
+        using callbacks     = event_loop::callbacks;
+        using timeouts      = event_loop::timeouts;
+        using timeout_kind  = event_loop::timeout_kind;
+
+    public:
+        sharded_stream_server()     = default;
+        ~sharded_stream_server()    { stop(); }
+
+        sharded_stream_server(const sharded_stream_server&)             = delete;
+        sharded_stream_server& operator=(const sharded_stream_server&)  = delete;
+
+        sharded_stream_server(sharded_stream_server&&)                  = delete;
+        sharded_stream_server& operator=(sharded_stream_server&&)       = delete;
+
+        /// @brief binds every worker's listener and starts the worker threads.
+        /// @param ip local ip to bind.
+        /// @param port local port to bind, 0 picks one (see port()).
+        /// @param cbs the callbacks, every worker gets a copy.
+        /// @param worker_count amount of workers, 0 -> one per hardware thread.
+        /// @return true -> running, false -> a listener couldn't be created.
+        bool start(
+            const std::string& ip,
+            const uint16_t port,
+            callbacks cbs,
+            size_t worker_count = 0)
+        {
+            stop();
+
+            if (worker_count == 0) worker_count = std::max(1u, std::thread::hardware_concurrency());
+            if (!socket::supports_reuse_port) worker_count = 1;
+
+            _callbacks = std::move(cbs);
+            _port = port;
+
+            for (size_t i = 0; i < worker_count; ++i)
+            {
+                auto w = std::make_unique<worker>(i);
+                w->set_callbacks(_callbacks);
+                w->set_send_limits(_send_limits);
+                w->set_timeouts(_timeouts);
+
+                if (!w->listen(ip, _port, 1024, socket::supports_reuse_port))
+                {
+                    _workers.clear();
+                    return false;
+                }
+
+                // the first listener decides the port when 0 was given.
+                if (_port == 0) _port = w->port();
+                _workers.push_back(std::move(w));
+            }
+
+            _running.store(true);
+            for (auto& w : _workers)
+                _threads.emplace_back([this, ptr = w.get()] { ptr->run(_running, _stop_check_ms); });
+
+            return true;
+        }
+
+        /// @brief stops and joins every worker, closes all connections.
+        void stop()
+        {
+            _running.store(false);
+            for (std::thread& t : _threads)
+                if (t.joinable()) t.join();
+            _threads.clear();
+            _workers.clear();
+        }
+
+        /// @brief send queue limits every new connection gets, set before start().
+        void set_send_limits(const stream_socket::send_limits& limits) { _send_limits = limits; }
+
+        /// @brief timeouts every connection gets, set before start().
+        void set_timeouts(const timeouts& t) { _timeouts = t; }
+
+        BANKER_NODISCARD bool is_running() const { return _running.load(); }
+
+        BANKER_NODISCARD size_t worker_count() const { return _workers.size(); }
+
+        /// @brief the port every worker listens on.
+        BANKER_NODISCARD uint16_t port() const { return _port; }
+
+    private:
+        /// @brief how often an idle worker looks at _running.
+        static constexpr int _stop_check_ms = 100;
+
+        callbacks                               _callbacks{};
+        stream_socket::send_limits              _send_limits{};
+        timeouts                                _timeouts{};
+        std::vector<std::unique_ptr<worker>>    _workers{};
+        std::vector<std::thread>                _threads{};
+        std::atomic<bool>                       _running{false};
+        uint16_t                                _port{0};
+    };
+}
+
+#endif //BANKER_SHARDED_STREAM_SERVER_HPP
@@ -5,10 +5,13 @@
 #ifndef BANKER_TESTER_HPP
 #define BANKER_TESTER_HPP
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <utility>
 
 namespace banker::tester
 {
@@ -34,6 +37,32 @@ namespace banker::tester
 
     inline thread_local std::vector<std::string> current_group_messages;
 
+    /// @brief small deterministic generator (64 bit lcg), the same seed always gives the same run.
+    struct test_rng
+    {
+        uint64_t seed{0};
+
+        /// @return the upper 31 bits of the next state.
+        uint64_t next()
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            return seed >> 33;
+        }
+
+        uint64_t operator()() { return next(); }
+    };
+
+    /// @brief runs f once.
+    /// @return {microseconds it took, what f returned}, keep the result so the work isn't optimized out.
+    template<typename F>
+    auto time_us(F&& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto result = f();
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        return std::pair{us, result};
+    }
+
 
     struct test_case
     {
@@ -0,0 +1,71 @@
+/* ================================== *\
+ @file     buffer_pool_tests.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_BUFFER_POOL_TESTS_HPP
+#define BANKER_BUFFER_POOL_TESTS_HPP
+
+#include "banker/common/containers/buffer_pool.hpp"
+#include "banker/core/networker/core/packet/packet.hpp"
+#include "banker/core/networker/core/stream_socket/stream_socket_core.hpp"
+#include "banker/tester/tester.hpp"
+
+BANKER_TEST_CASE(buffer_pool, reuse, "Allocates and frees blocks and checks they are reused and counted.")
+{
+    banker::buffer_pool pool{};
+
+    void* a = pool.allocate(100);
+    pool.deallocate(a, 100);
+    void* b = pool.allocate(120);
+    if (a != b) BANKER_FAIL("a freed block of the same class wasn't reused.");
+
+    void* big = pool.allocate(banker::buffer_pool::max_block + 1);
+    pool.deallocate(big, banker::buffer_pool::max_block + 1);
+    pool.deallocate(b, 120);
+
+    const auto& s = pool.get_stats();
+    BANKER_MSG("allocations: ", s.allocations, " hits: ", s.hits, " misses: ", s.misses,
+               " high water: ", s.high_water_bytes, " cached: ", s.bytes_cached);
+
+    if (s.allocations != 3) BANKER_FAIL("wrong allocation count.");
+    if (s.hits != 1) BANKER_FAIL("wrong hit count.");
+    if (s.oversized != 1) BANKER_FAIL("wrong oversized count.");
+    if (s.bytes_in_use != 0) BANKER_FAIL("bytes still in use: ", s.bytes_in_use);
+    if (s.high_water_bytes != 128 + banker::buffer_pool::max_block + 1) BANKER_FAIL("wrong high water mark.");
+    if (s.bytes_cached != 128) BANKER_FAIL("wrong cached bytes: ", s.bytes_cached);
+
+    pool.trim();
+    if (pool.get_stats().bytes_cached != 0) BANKER_FAIL("trim left cached bytes.");
+}
+
+BANKER_TEST_CASE(buffer_pool, warm_send_path, "Enqueues and sends pooled packets and checks a warm pool doesn't miss.")
+{
+    using core = banker::networker::stream_socket_core;
+    auto& pool = banker::buffer_pool::local();
+
+    const auto round = [](core::send_state& state)
+    {
+        banker::networker::pooled_packet pkt;
+        pkt.write(uint64_t{42});
+        pkt.write(std::string("snapshot"));
+        core::enqueue(state, pkt.serialize_to_stream());
+        core::enqueue(state, std::vector<uint8_t>{1, 2, 3});
+        (void)core::consume_sent(state, state.out_buffers[0].size(0) + 3);
+    };
+
+    core::send_state state{};
+    for (int i = 0; i < 16; ++i) round(state);
+
+    pool.reset_stats();
+    for (int i = 0; i < 1000; ++i) round(state);
+
+    const auto& s = pool.get_stats();
+    BANKER_MSG("allocations: ", s.allocations, " hit rate: ", s.hit_rate());
+    if (s.allocations == 0) BANKER_FAIL("nothing came from the pool.");
+    if (s.misses != 0) BANKER_FAIL("warm send path missed ", s.misses, " time(s).");
+}
+
+#endif //BANKER_BUFFER_POOL_TESTS_HPP
@@ -8,8 +8,18 @@
 #include "banker/core/crypto/crypter.hpp"
 #include "banker/core/crypto/format_bytes.hpp"
 #include "banker/core/networker/crypto/crypto_core.hpp"
+#include "banker/core/networker/crypto/crypto_pool.hpp"
+#include "banker/core/networker/crypto/crypto_session.hpp"
 #include "banker/tester/tester.hpp"
 
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
 BANKER_TEST_CASE(packet_encryption_and_decryption, simple, "Tries to encypt and decrypt a very simple packet.")
 {
     std::vector<uint8_t> stream{};
@@ -197,4 +207,180 @@ BANKER_TEST_CASE(encryption_and_decryption, hello_world_4, "Messes with the KEY
     }
 }
 
+BANKER_TEST_CASE(crypto_session, round_trip, "Seals packets both ways through a pair of sessions and checks tampering breaks the session.")
+{
+    using banker::networker::crypto_session;
+
+    banker::crypter::handshake a{};
+    banker::crypter::handshake b{};
+    a.generate_shared_secret(b.get_public());
+    b.generate_shared_secret(a.get_public());
+
+    crypto_session client{a.get_shared_secret(), crypto_session::role::initiator};
+    crypto_session server{b.get_shared_secret(), crypto_session::role::responder};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        banker::networker::packet pkt{};
+        pkt.write(i);
+        pkt.write(std::string("message"));
+        const std::vector<uint8_t> plain(pkt.get_data().begin(), pkt.get_data().end());
+
+        auto& sender = (i % 2 == 0) ? client : server;
+        auto& receiver = (i % 2 == 0) ? server : client;
+
+        const uint32_t header = static_cast<uint32_t>(plain.size());
+        const std::span<const uint8_t> ad{reinterpret_cast<const uint8_t*>(&header), sizeof(header)};
+
+        const auto mac = sender.seal_packet(pkt, ad);
+        if (!mac) BANKER_FAIL("message ", i, " wasn't sealed.");
+        if (std::equal(plain.begin(), plain.end(), pkt.get_data().begin())) BANKER_FAIL("message ", i, " wasn't encrypted.");
+        if (!receiver.open_packet(pkt, *mac, ad)) BANKER_FAIL("message ", i, " failed to open.");
+        if (pkt.read<int>() != i || pkt.read<std::string>() != "message") BANKER_FAIL("message ", i, " corrupted.");
+    }
+    if (client.sealed() != 50 || server.opened() != 50) BANKER_FAIL("wrong message counts.");
+
+    // the same plaintext twice never gives the same cipher text, the key ratchets.
+    std::vector<uint8_t> first(32, 1);
+    std::vector<uint8_t> second(32, 1);
+    const auto mac_first = client.seal(first);
+    const auto mac_second = client.seal(second);
+    if (first == second) BANKER_FAIL("cipher text repeated.");
+
+    // out of order is rejected and breaks the session.
+    if (!mac_first || !mac_second) BANKER_FAIL("valid session refused to seal.");
+    if (server.open(second, *mac_second)) BANKER_FAIL("opened a message out of order.");
+    if (server.is_valid()) BANKER_FAIL("session still valid after a failed open.");
+    if (server.open(first, *mac_first)) BANKER_FAIL("broken session opened a message.");
+
+    // a session without a key never seals: broken, default constructed or moved from.
+    std::vector<uint8_t> plain(16, 7);
+    const auto original = plain;
+    crypto_session empty{};
+    crypto_session moved{std::move(client)};
+    if (server.seal(plain) || empty.seal(plain) || client.seal(plain)) BANKER_FAIL("sealed without a valid key.");
+    if (plain != original) BANKER_FAIL("a refused seal touched the data.");
+    if (!moved.seal(plain)) BANKER_FAIL("moved to session refused to seal.");
+}
+
+BANKER_TEST_CASE(crypto_pool, batch, "Encrypts and decrypts a batch across workers and checks session jobs keep their order.")
+{
+    using banker::networker::crypto_pool;
+    using banker::networker::crypto_session;
+
+    crypto_pool pool{3};
+    BANKER_MSG("workers: ", pool.worker_count());
+
+    banker::crypter::key key{};
+    banker::crypto_rng::get(key);
+
+    // two connections, each with a sender and a receiver session.
+    crypto_session send[2] = {
+        crypto_session{key, crypto_session::role::initiator},
+        crypto_session{key, crypto_session::role::responder}};
+    crypto_session receive[2] = {
+        crypto_session{key, crypto_session::role::responder},
+        crypto_session{key, crypto_session::role::initiator}};
+
+    constexpr size_t count = 400;
+    std::vector<std::vector<uint8_t>> plain(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        plain[i].resize(256 + i);
+        for (size_t b = 0; b < plain[i].size(); ++b) plain[i][b] = static_cast<uint8_t>(i + b);
+    }
+    std::vector<std::vector<uint8_t>> buffers = plain;
+
+    // every third job is stateless with its own nonce, the rest alternate between the two sessions.
+    auto make_nonce = [](const size_t i)
+    {
+        banker::crypter::nonce n{};
+        std::memcpy(n.bytes, &i, sizeof(i));
+        return n;
+    };
+
+    std::vector<crypto_pool::job> jobs;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i % 3 == 0) jobs.push_back(crypto_pool::job::seal(key, make_nonce(i), buffers[i]));
+        else jobs.push_back(crypto_pool::job::seal(send[i % 2], buffers[i]));
+    }
+    pool.run(jobs);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!jobs[i].ok) BANKER_FAIL("encrypt job ", i, " failed.");
+        if (buffers[i] == plain[i]) BANKER_FAIL("job ", i, " wasn't encrypted.");
+    }
+
+    std::vector<crypto_pool::job> opens;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i % 3 == 0) opens.push_back(crypto_pool::job::open(key, make_nonce(i), buffers[i], jobs[i].mac));
+        else opens.push_back(crypto_pool::job::open(receive[i % 2], buffers[i], jobs[i].mac));
+    }
+    pool.run(opens);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!opens[i].ok) BANKER_FAIL("decrypt job ", i, " failed (order lost?).");
+        if (buffers[i] != plain[i]) BANKER_FAIL("job ", i, " decrypted wrong.");
+    }
+}
+
+BANKER_TEST_CASE(crypto_rng, buffered, "Draws small and large amounts from the buffered generator and checks they look random and never repeat.")
+{
+    uint8_t a[32]{};
+    uint8_t b[32]{};
+    if (!banker::crypto_rng::get(a) || !banker::crypto_rng::get(b)) BANKER_FAIL("generator failed.");
+    if (std::memcmp(a, b, sizeof(a)) == 0) BANKER_FAIL("two draws were the same.");
+
+    // crosses several refills and a reseed.
+    std::vector<uint8_t> large(banker::crypto_rng::reseed_interval + 1000);
+    if (!banker::crypto_rng::get_bytes(large.data(), large.size())) BANKER_FAIL("large draw failed.");
+
+    size_t counts[256]{};
+    for (const uint8_t byte : large) ++counts[byte];
+    const size_t expected = large.size() / 256;
+    for (const size_t count : counts)
+    {
+        if (count < expected / 2 || count > expected * 2) BANKER_FAIL("byte distribution is off: ", count, " vs ~", expected);
+    }
+
+    uint8_t os[32]{};
+    if (!banker::crypto_rng::get_os_bytes(os, sizeof(os))) BANKER_FAIL("OS source failed.");
+}
+
+#ifndef _WIN32
+BANKER_TEST_CASE(crypto_rng, fork, "Forks after using the generator and checks the child doesn't repeat the parent's bytes.")
+{
+    uint8_t warm[16]{};
+    (void)banker::crypto_rng::get(warm);
+
+    int fds[2];
+    if (::pipe(fds) != 0) BANKER_FAIL("pipe failed.");
+
+    const pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        uint8_t child[32]{};
+        (void)banker::crypto_rng::get(child);
+        (void)!::write(fds[1], child, sizeof(child));
+        ::_exit(0);
+    }
+
+    uint8_t parent[32]{};
+    (void)banker::crypto_rng::get(parent);
+
+    uint8_t child[32]{};
+    const ssize_t r = ::read(fds[0], child, sizeof(child));
+    ::close(fds[0]);
+    ::close(fds[1]);
+    ::waitpid(pid, nullptr, 0);
+
+    if (r != static_cast<ssize_t>(sizeof(child))) BANKER_FAIL("child didn't report its bytes.");
+    if (std::memcmp(parent, child, sizeof(child)) == 0) BANKER_FAIL("parent and child produced the same bytes.");
+}
+#endif
+
 #endif //BANKER_ENCRYPTION_TESTS_HPP
\ No newline at end of file
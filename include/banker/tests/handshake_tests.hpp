@@ -7,6 +7,8 @@
 
 #include "banker/core/crypto/crypter.hpp"
 #include "banker/core/crypto/format_bytes.hpp"
+#include "banker/core/crypto/keypair_pool.hpp"
+#include "banker/core/crypto/resumption.hpp"
 #include "banker/tester/tester.hpp"
 
 BANKER_TEST_CASE(handshake, base, "Tests a simple handshake between a and b")
@@ -61,4 +63,83 @@ BANKER_TEST_CASE(handshake, modified, "Tries to sabotage a's public key to stop
     }
 }
 
+BANKER_TEST_CASE(handshake, keypair_pool, "Takes pregenerated key pairs from the pool and runs a batch of handshakes against plain ones.")
+{
+    banker::crypter::keypair_pool pool{64, 2};
+    pool.wait_full();
+    BANKER_MSG("stock: ", pool.available(), "/", pool.capacity());
+
+    constexpr size_t count = 48;
+    std::vector<banker::crypter::handshake> servers;
+    std::vector<banker::crypter::handshake> clients;
+    std::vector<banker::crypter::key> client_publics;
+    std::vector<banker::crypter::key> server_publics;
+    for (size_t i = 0; i < count; ++i)
+    {
+        servers.push_back(pool.take_handshake());
+        clients.emplace_back();
+        client_publics.push_back(clients.back().get_public());
+        server_publics.push_back(servers.back().get_public());
+    }
+
+    const auto stats = pool.get_stats();
+    BANKER_MSG("hits: ", stats.hits, " misses: ", stats.misses);
+    if (stats.hits == 0) BANKER_FAIL("no key pair came from the stock.");
+
+    pool.generate_shared_secrets(servers, client_publics);
+    for (size_t i = 0; i < count; ++i) clients[i].generate_shared_secret(server_publics[i]);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!servers[i].is_shared_valid()) BANKER_FAIL("batch skipped handshake ", i);
+        if (servers[i].get_shared_secret() != clients[i].get_shared_secret()) BANKER_FAIL("handshake ", i, " disagrees.");
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (servers[i].get_public() == servers[j].get_public()) BANKER_FAIL("key pair ", i, " handed out twice.");
+        }
+    }
+}
+
+BANKER_TEST_CASE(handshake, resumption, "Resumes a session from a ticket and checks forged, expired and rotated out tickets are refused.")
+{
+    using namespace banker::crypter;
+
+    handshake a{};
+    handshake b{};
+    a.generate_shared_secret(b.get_public());
+    b.generate_shared_secret(a.get_public());
+
+    constexpr uint64_t start = 1'000'000;
+    ticket_issuer issuer{std::chrono::seconds(100), std::chrono::seconds(10), 3};
+    const ticket t = issuer.issue(b.get_shared_secret(), start);
+
+    // the client comes back with the ticket and a fresh nonce.
+    resume_nonce client_nonce{};
+    resume_nonce server_nonce{};
+    banker::crypto_rng::get(client_nonce.bytes);
+    banker::crypto_rng::get(server_nonce.bytes);
+
+    key old{};
+    if (!issuer.redeem(t, old, start + 5)) BANKER_FAIL("valid ticket refused.");
+
+    const key server_key = resumed_secret(old, client_nonce, server_nonce);
+    const key client_key = resumed_secret(a.get_shared_secret(), client_nonce, server_nonce);
+    if (server_key != client_key) BANKER_FAIL("resumed keys disagree.");
+    if (server_key == a.get_shared_secret()) BANKER_FAIL("resumed key is the old secret.");
+
+    banker::crypto_rng::get(server_nonce.bytes);
+    if (resumed_secret(old, client_nonce, server_nonce) == server_key) BANKER_FAIL("fresh nonces gave the same key.");
+
+    ticket forged = t;
+    forged.bytes[ticket::size - 1] ^= 0x01;
+    if (issuer.redeem(forged, old, start + 5)) BANKER_FAIL("forged ticket redeemed.");
+
+    if (issuer.redeem(t, old, start + 101)) BANKER_FAIL("expired ticket redeemed.");
+
+    // issuing past the rotation interval rotates, after max_keys rotations the first key is gone.
+    for (uint64_t i = 1; i <= 3; ++i) (void)issuer.issue(b.get_shared_secret(), start + i * 10);
+    if (issuer.key_count() != 3) BANKER_FAIL("key cache not bounded: ", issuer.key_count());
+    if (issuer.redeem(t, old, start + 35)) BANKER_FAIL("ticket of a rotated out key redeemed.");
+}
+
 #endif //BANKER_HANDSHAKE_TESTS_HPP
\ No newline at end of file
@@ -5,9 +5,13 @@
 #ifndef BANKER_PACKET_TESTS_HPP
 #define BANKER_PACKET_TESTS_HPP
 
+#include <array>
+
 #include "banker/debug_inspector.hpp"
 #include "banker/core/crypto/format_bytes.hpp"
 #include "banker/core/networker/core/packet/packet.hpp"
+#include "banker/core/networker/core/packet/packet_view.hpp"
+#include "banker/core/networker/core/stream_socket/stream_receive_buffer.hpp"
 #include "banker/tester/tester.hpp"
 
 BANKER_TEST_CASE(packets, 2_ints, "Creates a packet, puts 2 ints into it and tries getting the same 2 out.")
@@ -140,4 +144,236 @@ BANKER_TEST_CASE(packets, packet_inception, "Creates a packet and embeds another
 
 }
 
+BANKER_TEST_CASE(packets, frame_reader, "Serializes a few packets into one stream and reads them back as views in one pass.")
+{
+    banker::networker::stream_receive_buffer stream{};
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        banker::networker::packet pkt;
+        pkt.write(i);
+        pkt.write(std::string("frame ") + std::to_string(i));
+        const auto bytes = pkt.serialize_to_stream();
+        stream.append(bytes.data(), bytes.size());
+    }
+
+    // half of a 6th frame, must be left alone.
+    const uint8_t partial[] = {0, 0, 0, 9, 1, 2};
+    stream.append(partial, sizeof(partial));
+
+    const auto bytes = stream.contiguous();
+    banker::networker::frame_reader frames{bytes};
+
+    uint32_t count = 0;
+    for (banker::networker::packet_view frame : frames)
+    {
+        bool valid = false;
+        const auto index = frame.read<uint32_t>(&valid);
+        const auto text = frame.read<std::string_view>(&valid);
+        if (!valid) BANKER_FAIL("frame ", count, " couldn't be read.");
+        if (index != count) BANKER_FAIL("frame ", count, " has index ", index);
+        if (text != "frame " + std::to_string(count)) BANKER_FAIL("frame ", count, " has text ", text);
+        if (text.data() < reinterpret_cast<const char*>(bytes.data()) ||
+            text.data() >= reinterpret_cast<const char*>(bytes.data() + bytes.size()))
+            BANKER_FAIL("string_view doesn't point into the stream.");
+        ++count;
+    }
+
+    BANKER_MSG("frames: ", count, " consumed: ", frames.consumed(), " of ", bytes.size());
+    if (count != 5) BANKER_FAIL("wrong amount of frames: ", count);
+
+    stream.consume(frames.consumed());
+    if (stream.size() != sizeof(partial)) BANKER_FAIL("partial frame got consumed.");
+
+    bool valid = true;
+    banker::networker::packet_view broken{std::span<const uint8_t>(partial, 2)};
+    (void)broken.read<uint32_t>(&valid);
+    if (valid) BANKER_FAIL("reading past the end should fail.");
+}
+
+BANKER_TEST_CASE(packets, bulk_sequences, "Writes vectors, spans and arrays of trivially copyable data into a reserved packet and reads them back.")
+{
+    std::vector<uint32_t> levels(1000);
+    for (size_t i = 0; i < levels.size(); ++i) levels[i] = static_cast<uint32_t>(i * 31);
+    const std::array<int16_t, 4> side{-1, 2, -3, 4};
+    const double prices[] = {1.5, 2.25, 3.125};
+    const std::span<const double> price_span{prices};
+
+    banker::networker::packet pkt;
+    const size_t expected =
+        banker::networker::packet::encoded_size(levels) +
+        banker::networker::packet::encoded_size(side) +
+        sizeof(uint32_t) + sizeof(prices);
+    pkt.reserve(expected);
+    const auto* storage = pkt.get_data().data();
+
+    pkt.write(levels);
+    pkt.write(side);
+    pkt.write(price_span);
+
+    BANKER_MSG("expected: ", expected, " size: ", pkt.get_data().size());
+    if (pkt.get_data().size() != expected) BANKER_FAIL("encoded_size doesn't match what got written.");
+    if (pkt.get_data().data() != storage) BANKER_FAIL("writing after reserve reallocated.");
+
+    bool valid = false;
+    const auto levels_out = pkt.read<std::vector<uint32_t>>(&valid);
+    const auto side_out = pkt.read<std::array<int16_t, 4>>(&valid);
+    const auto prices_out = pkt.read<std::vector<double>>(&valid);
+    if (!valid) BANKER_FAIL("couldn't read back.");
+
+    if (levels_out != levels) BANKER_FAIL("vector got corrupted.");
+    if (side_out != side) BANKER_FAIL("array got corrupted.");
+    if (prices_out.size() != 3 || prices_out[2] != 3.125) BANKER_FAIL("span got corrupted.");
+
+    (void)pkt.read<std::vector<uint64_t>>(&valid);
+    if (valid) BANKER_FAIL("reading past the end should fail.");
+}
+
+namespace banker::tests
+{
+    struct test_level
+    {
+        double price;
+        uint32_t quantity;
+
+        BANKER_FIELDS(price, quantity)
+    };
+
+    struct test_order
+    {
+        uint64_t id;
+        test_level level;
+        uint8_t side;
+        std::string account;
+        std::vector<test_level> fills;
+
+        BANKER_FIELDS(id, level, side, account, fills)
+    };
+
+    struct test_c_array
+    {
+        uint32_t id;
+        uint16_t raw[3];
+
+        BANKER_FIELDS(id, raw)
+    };
+
+    struct test_std_array
+    {
+        uint32_t id;
+        std::array<uint16_t, 3> raw;
+
+        BANKER_FIELDS(id, raw)
+    };
+}
+
+BANKER_TEST_CASE(packets, fields, "Writes a BANKER_FIELDS struct and checks it matches field by field writes and reads back.")
+{
+    using banker::tests::test_level;
+    using banker::tests::test_order;
+    namespace fields = banker::networker::fields;
+
+    static_assert(fields::fixed_size<test_level>() == sizeof(double) + sizeof(uint32_t));
+    static_assert(fields::fixed_prefix_count<test_order>() == 3);
+    static_assert(fields::fixed_prefix_size<test_order>() == 8 + 12 + 1);
+
+    // a C array is counted once per element by brace elision, check() refuses it, std::array counts once.
+    static_assert(fields::has_array_field<banker::tests::test_c_array>());
+    static_assert(!fields::has_array_field<banker::tests::test_std_array>());
+    static_assert(fields::aggregate_field_count<banker::tests::test_std_array>() == 2);
+
+    const test_order order{7, {101.5, 30}, 1, "acc-1", {{101.5, 10}, {101.25, 20}}};
+
+    banker::networker::packet fused;
+    fused.write(order);
+
+    banker::networker::packet manual;
+    manual.write(order.id);
+    manual.write(order.level.price);
+    manual.write(order.level.quantity);
+    manual.write(order.side);
+    manual.write(order.account);
+    manual.write(static_cast<uint32_t>(order.fills.size()));
+    for (const auto& fill : order.fills) { manual.write(fill.price); manual.write(fill.quantity); }
+
+    BANKER_MSG("fused: ", fused.get_data().size(), " manual: ", manual.get_data().size(),
+               " encoded_size: ", banker::networker::packet::encoded_size(order));
+    if (fused.get_data().size() != manual.get_data().size() ||
+        std::memcmp(fused.get_data().data(), manual.get_data().data(), manual.get_data().size()) != 0)
+        BANKER_FAIL("fused write differs from field by field writes.");
+    if (banker::networker::packet::encoded_size(order) != fused.get_data().size())
+        BANKER_FAIL("encoded_size is wrong.");
+
+    bool valid = false;
+    const auto out = fused.read<test_order>(&valid);
+    if (!valid) BANKER_FAIL("couldn't read back.");
+    if (out.id != 7 || out.level.price != 101.5 || out.level.quantity != 30 || out.side != 1)
+        BANKER_FAIL("fixed fields got corrupted.");
+    if (out.account != "acc-1") BANKER_FAIL("string field got corrupted.");
+    if (out.fills.size() != 2 || out.fills[1].price != 101.25 || out.fills[1].quantity != 20)
+        BANKER_FAIL("vector field got corrupted.");
+
+    banker::networker::packet_view truncated{fused.get_data().first(10)};
+    (void)truncated.read<test_order>(&valid);
+    if (valid) BANKER_FAIL("reading a truncated struct should fail.");
+}
+
+namespace banker::tests
+{
+    struct test_tick
+    {
+        banker::networker::varint<uint32_t> instrument;
+        banker::networker::varint<int64_t> change;
+        banker::networker::delta_sequence<uint64_t> timestamps;
+
+        BANKER_FIELDS(instrument, change, timestamps)
+    };
+}
+
+BANKER_TEST_CASE(packets, varint_delta, "Writes varints and delta sequences and checks their size and that they read back.")
+{
+    namespace enc = banker::networker::encoding;
+    using banker::networker::packet;
+
+    for (const int64_t v : {int64_t{0}, int64_t{-1}, int64_t{1}, int64_t{-64}, INT64_MIN, INT64_MAX})
+        if (enc::zigzag_decode(enc::zigzag_encode(v)) != v) BANKER_FAIL("zigzag doesn't round trip ", v);
+
+    std::vector<uint64_t> stamps;
+    for (uint64_t i = 0; i < 100; ++i) stamps.push_back(1'700'000'000'000'000ull + i * 3);
+
+    const banker::tests::test_tick tick{42, -3, {stamps}};
+
+    packet pkt;
+    pkt.write(tick);
+    pkt.write(packet::varint<uint64_t>{UINT64_MAX});
+
+    const size_t fixed = sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint32_t) + stamps.size() * sizeof(uint64_t);
+    BANKER_MSG("encoded: ", pkt.get_data().size(), " fixed would be: ", fixed + sizeof(uint64_t));
+    if (packet::encoded_size(tick) + enc::max_varint_size != pkt.get_data().size()) BANKER_FAIL("encoded_size is wrong.");
+    if (pkt.get_data().size() * 4 > fixed) BANKER_FAIL("encoding isn't compact.");
+
+    bool valid = false;
+    const auto out = pkt.read<banker::tests::test_tick>(&valid);
+    const uint64_t max = pkt.read<packet::varint<uint64_t>>(&valid);
+    if (!valid) BANKER_FAIL("couldn't read back.");
+    if (out.instrument != 42u || out.change != -3) BANKER_FAIL("varints got corrupted.");
+    if (out.timestamps.values != stamps) BANKER_FAIL("delta sequence got corrupted.");
+    if (max != UINT64_MAX) BANKER_FAIL("max varint got corrupted.");
+
+    packet big;
+    big.write(packet::varint<uint32_t>{70000});
+    (void)big.read<packet::varint<uint16_t>>(&valid);
+    if (valid) BANKER_FAIL("a varint too big for its type should fail.");
+
+    const uint8_t truncated[] = {0x80, 0x80};
+    banker::networker::packet_view view{std::span<const uint8_t>(truncated)};
+    (void)view.read<packet::varint<uint32_t>>(&valid);
+    if (valid) BANKER_FAIL("a truncated varint should fail.");
+
+    // 10 bytes, the last one carrying bits past 64.
+    const uint8_t overflow[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02};
+    banker::networker::packet_view too_long{std::span<const uint8_t>(overflow)};
+    (void)too_long.read<packet::varint<uint64_t>>(&valid);
+    if (valid) BANKER_FAIL("a varint overflowing 64 bits should fail.");
+}
+
 #endif //BANKER_PACKET_TESTS_HPP
\ No newline at end of file
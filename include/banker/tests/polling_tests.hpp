@@ -0,0 +1,99 @@
+/* ================================== *\
+ @file     polling_tests.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_POLLING_TESTS_HPP
+#define BANKER_POLLING_TESTS_HPP
+
+#include "banker/core/networker/core/socket/polling.hpp"
+#include "banker/core/networker/core/stream_socket/stream_socket_core.hpp"
+#include "banker/tester/tester.hpp"
+
+namespace banker::tests
+{
+    /// @brief a connected loopback pair, [0] is the accepted side, [1] the connecting side.
+    inline std::pair<networker::socket, networker::socket> make_loopback_pair()
+    {
+        networker::socket listener =
+            networker::stream_socket_core::new_server_socket("127.0.0.1", 0);
+        if (!listener.is_valid()) return std::pair<networker::socket, networker::socket>{};
+
+        networker::socket client =
+            networker::stream_socket_core::new_client_socket(
+                "127.0.0.1",
+                listener.get_local_info().port);
+
+        if (!listener.is_readable(1000)) return std::pair<networker::socket, networker::socket>{};
+        networker::socket accepted =
+            networker::stream_socket_core::new_accepted_socket(listener);
+
+        return {std::move(accepted), std::move(client)};
+    }
+}
+
+BANKER_TEST_CASE(polling, readable_user_data, "Polls an accepted socket and checks readiness and user data.")
+{
+    auto [server_side, client_side] = banker::tests::make_loopback_pair();
+    if (!server_side.is_valid() || !client_side.is_valid()) BANKER_FAIL("can't create loopback pair.");
+
+    banker::networker::poll_group pg{};
+    if (!pg.is_valid()) BANKER_FAIL("can't create poll group.");
+    if (!pg.add(server_side, banker::networker::poll_group::interest::read, 42))
+        BANKER_FAIL("can't add socket.");
+
+    banker::networker::poll_group::result result;
+    BANKER_MSG("ready before send: ", pg.poll(0));
+    if (pg.next_result(result) != -1) BANKER_FAIL("socket is ready but nothing has been sent.");
+
+    const char msg[] = "ping";
+    if (client_side.send(msg, sizeof(msg)) != sizeof(msg)) BANKER_FAIL("can't send.");
+
+    BANKER_MSG("ready after send: ", pg.poll(1000));
+    if (pg.next_result(result) == -1) BANKER_FAIL("socket should be readable.");
+    BANKER_MSG("fd: ", result.fd, " user_data: ", result.user_data);
+    if (!result.readable) BANKER_FAIL("result isn't readable.");
+    if (result.writable) BANKER_FAIL("result is writable but write interest wasn't requested.");
+    if (result.user_data != 42) BANKER_FAIL("wrong user data: ", result.user_data);
+    if (pg.next_result(result) != -1) BANKER_FAIL("only 1 socket should be ready.");
+
+    if (!pg.modify(server_side, banker::networker::poll_group::interest::write))
+        BANKER_FAIL("can't modify socket.");
+    pg.poll(1000);
+    if (pg.next_result(result) == -1 || !result.writable || result.user_data != 42)
+        BANKER_FAIL("modify should keep the user data and report writable.");
+
+    if (!pg.remove(server_side)) BANKER_FAIL("can't remove socket.");
+    if (pg.poll(0) != 0) BANKER_FAIL("removed socket still reported.");
+    if (pg.user_data_of(server_side) != 0) BANKER_FAIL("removed socket kept its user data.");
+}
+
+BANKER_TEST_CASE(polling, edge_trigger, "Checks that edge triggering only reports a readiness change once.")
+{
+    auto [server_side, client_side] = banker::tests::make_loopback_pair();
+    if (!server_side.is_valid() || !client_side.is_valid()) BANKER_FAIL("can't create loopback pair.");
+
+    banker::networker::poll_group level{banker::networker::poll_group::trigger::level};
+    banker::networker::poll_group edge{banker::networker::poll_group::trigger::edge};
+    level.add(server_side, banker::networker::poll_group::interest::read);
+    edge.add(server_side, banker::networker::poll_group::interest::read);
+
+    const char msg[] = "ping";
+    if (client_side.send(msg, sizeof(msg)) != sizeof(msg)) BANKER_FAIL("can't send.");
+
+    const int level_first = level.poll(1000);
+    const int edge_first = edge.poll(1000);
+    const int level_second = level.poll(0);
+    const int edge_second = edge.poll(0);
+    BANKER_MSG("level: ", level_first, " -> ", level_second);
+    BANKER_MSG("edge: ", edge_first, " -> ", edge_second);
+
+    if (level_first != 1 || level_second != 1) BANKER_FAIL("level trigger should keep reporting unread data.");
+#ifndef _WIN32
+    if (edge_first != 1 || edge_second != 0) BANKER_FAIL("edge trigger should report unread data once.");
+#endif
+}
+
+#endif //BANKER_POLLING_TESTS_HPP
@@ -8,6 +8,14 @@
 #ifndef BANKER_ROBIN_HASH_TESTS_HPP
 #define BANKER_ROBIN_HASH_TESTS_HPP
 
+#include <memory>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "banker/common/hash/concurrent_robin_map.hpp"
 #include "banker/common/hash/robin_hash.hpp"
 #include "banker/tester/tester.hpp"
 
@@ -71,4 +79,202 @@ BANKER_TEST_CASE(robin_hash, add_remove, "simply adds and removes and checks")
     }
 }
 
+BANKER_TEST_CASE(robin_hash, clustered_keys, "Inserts aligned and slot map style keys, which used to cluster, and checks lookups, erase and iteration.")
+{
+    banker::common::robin_map<uint64_t, uint64_t> rm{};
+
+    // fds * 8 and (generation << 32 | index) ids, both were identity hashed before.
+    constexpr uint64_t count = 100000;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        rm.insert(i * 8, i);
+        rm.insert((uint64_t{1} << 32) | i, i);
+    }
+    if (rm.size() != count * 2) BANKER_FAIL("size ", rm.size(), " != ", count * 2);
+
+    for (uint64_t i = 0; i < count; i += 2)
+    {
+        if (!rm.erase(i * 8)) BANKER_FAIL("key ", i * 8, " missing on erase.");
+    }
+
+    uint64_t sum = 0;
+    size_t seen = 0;
+    for (auto [key, value] : rm)
+    {
+        sum += value;
+        ++seen;
+        (void)key;
+    }
+    if (seen != rm.size()) BANKER_FAIL("iterated ", seen, " of ", rm.size());
+
+    const uint64_t all = count * (count - 1) / 2;
+    const uint64_t odd = (count / 2) * (count / 2);
+    if (sum != all + odd) BANKER_FAIL("iteration sum ", sum, " != ", all + odd);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        const bool expect = i % 2 == 1;
+        if ((rm.find(i * 8) != nullptr) != expect) BANKER_FAIL("key ", i * 8, " wrong after erase.");
+        if (rm.find((uint64_t{1} << 32) | i) == nullptr) BANKER_FAIL("id ", i, " lost.");
+    }
+}
+
+BANKER_TEST_CASE(robin_hash, hasher_and_moves, "Uses string keys and move only values, checks reserve and rehash keep everything.")
+{
+    banker::common::robin_map<std::string, std::unique_ptr<int>> rm{};
+    rm.reserve(1000);
+    const size_t capacity = rm.capacity();
+
+    for (int i = 0; i < 1000; ++i) rm.insert("key " + std::to_string(i), std::make_unique<int>(i));
+    if (rm.capacity() != capacity) BANKER_FAIL("rehashed after reserve.");
+
+    // grows past the reservation, values are moved, not copied.
+    for (int i = 1000; i < 5000; ++i) rm.insert("key " + std::to_string(i), std::make_unique<int>(i));
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        const auto* v = rm.find("key " + std::to_string(i));
+        if (v == nullptr || **v != i) BANKER_FAIL("key ", i, " lost.");
+    }
+
+    if (rm.insert("key 7", std::make_unique<int>(-7))) BANKER_FAIL("overwrite reported a new key.");
+    if (**rm.find("key 7") != -7) BANKER_FAIL("overwrite didn't stick.");
+
+    banker::common::robin_map<std::string, std::unique_ptr<int>> moved = std::move(rm);
+    if (moved.size() != 5000 || !rm.empty()) BANKER_FAIL("move didn't transfer.");
+
+    // a seeded hasher comes along with a copy, load_factor is still the third parameter.
+    struct seeded_hash
+    {
+        uint64_t seed{0};
+        uint64_t operator()(const uint64_t key) const { return banker::common::mix64(key ^ seed); }
+    };
+
+    banker::common::robin_map<uint64_t, uint64_t, 0.5f, seeded_hash> seeded{16, seeded_hash{0x5eed}};
+    for (uint64_t i = 0; i < 100; ++i) seeded.insert(i, i);
+    if (seeded.capacity() < 200) BANKER_FAIL("load_factor 0.5 not applied, capacity ", seeded.capacity());
+
+    const auto copy = seeded;
+    if (copy.hash_function().seed != 0x5eed) BANKER_FAIL("copy lost the hasher's seed.");
+    for (uint64_t i = 0; i < 100; ++i)
+        if (copy.find(i) == nullptr || *copy.find(i) != i) BANKER_FAIL("copy lost key ", i);
+}
+
+BANKER_TEST_CASE(robin_hash, versus_unordered_map, "Times lookups of arbitrary 64 bit keys against std::unordered_map and bounds the probe lengths.")
+{
+    constexpr uint64_t count = 100000;
+    banker::common::robin_map<uint64_t, uint64_t> rm{};
+    std::unordered_map<uint64_t, uint64_t> um{};
+    rm.reserve(count);
+    um.reserve(count);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        const uint64_t id = banker::common::mix64(i);
+        rm.insert(id, i);
+        um[id] = i;
+    }
+
+    auto time = [&](auto&& lookup)
+    {
+        return banker::tester::time_us([&]
+        {
+            uint64_t sum = 0;
+            for (int round = 0; round < 5; ++round)
+                for (uint64_t i = 0; i < count; ++i) sum += lookup(banker::common::mix64((i * 7919) % count));
+            return sum;
+        });
+    };
+
+    const auto [robin_us, robin_sum] = time([&](const uint64_t id) { return *rm.find(id); });
+    const auto [std_us, std_sum] = time([&](const uint64_t id) { return um.find(id)->second; });
+
+    BANKER_MSG("robin_map: ", robin_us, " us, unordered_map: ", std_us, " us");
+    BANKER_MSG("probe length mean: ", rm.mean_probe_length(), " max: ", rm.max_probe_length());
+    if (robin_sum != std_sum) BANKER_FAIL("maps disagree.");
+
+    // timings are machine dependent, what makes lookups cheap is checked instead: with mixed keys
+    // at load_factor 0.7 nearly every lookup ends within a cache line or two of its home slot.
+    if (rm.mean_probe_length() > 2.0) BANKER_FAIL("mean probe length ", rm.mean_probe_length(), " > 2.");
+    if (rm.max_probe_length() > 32) BANKER_FAIL("max probe length ", rm.max_probe_length(), " > 32.");
+}
+
+BANKER_TEST_CASE(robin_hash, concurrent_readers, "Writers insert and erase while readers look up without locking, checks no reader sees a torn value.")
+{
+    constexpr uint64_t per_writer = 20000;
+    constexpr uint64_t writers = 2;
+    constexpr uint64_t readers = 4;
+
+    banker::common::concurrent_robin_map<uint64_t, uint64_t, banker::common::robin_hash<uint64_t>, 8> map{};
+    std::atomic<bool> writing{true};
+    std::atomic<uint64_t> bad{0};
+    std::atomic<uint64_t> hits{0};
+
+    std::vector<std::thread> threads{};
+    for (uint64_t r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&, r]
+        {
+            uint64_t local_hits = 0;
+            uint64_t key = r;
+            while (writing.load(std::memory_order_relaxed))
+            {
+                key = (key + 7919) % (per_writer * writers);
+                if (const auto value = map.find(key))
+                {
+                    if (*value != key * 3 && *value != key * 5) bad.fetch_add(1);
+                    ++local_hits;
+                }
+            }
+            hits.fetch_add(local_hits);
+        });
+    }
+
+    std::vector<std::thread> writer_threads{};
+    for (uint64_t w = 0; w < writers; ++w)
+    {
+        writer_threads.emplace_back([&, w]
+        {
+            const uint64_t first = w * per_writer;
+            for (uint64_t k = first; k < first + per_writer; ++k) map.insert(k, k * 3);
+            for (uint64_t k = first; k < first + per_writer; k += 2) map.insert(k, k * 5);
+            for (uint64_t k = first + 1; k < first + per_writer; k += 4) map.erase(k);
+        });
+    }
+
+    for (auto& t : writer_threads) t.join();
+    writing = false;
+    for (auto& t : threads) t.join();
+
+    BANKER_MSG("reader hits: ", hits.load());
+    if (bad.load() != 0) BANKER_FAIL(bad.load(), " lookups returned a value that was never written.");
+
+    const uint64_t expected = per_writer * writers - per_writer * writers / 4;
+    if (map.size() != expected) BANKER_FAIL("size ", map.size(), " expected ", expected);
+
+    uint64_t seen = 0;
+    map.for_each([&](const uint64_t k, const uint64_t v)
+    {
+        ++seen;
+        const uint64_t want = k % 2 == 0 ? k * 5 : k * 3;
+        if (v != want || k % 4 == 1) BANKER_FAIL("entry {", k, ", ", v, "} is wrong.");
+    });
+    if (seen != expected) BANKER_FAIL("for_each saw ", seen, " expected ", expected);
+
+    if (map.find(1).has_value() || !map.contains(3)) BANKER_FAIL("erase went wrong.");
+
+    // the callback may use the map, its own shard included (this used to deadlock).
+    size_t dropped = 0;
+    map.for_each([&](const uint64_t k, const uint64_t v)
+    {
+        if (map.find(k) != v) BANKER_FAIL("find from inside for_each disagrees on ", k);
+        if (k % 3 == 0 && map.erase(k)) ++dropped;
+    });
+    if (map.size() != expected - dropped) BANKER_FAIL("erase from inside for_each went wrong.");
+
+    map.reclaim();
+    map.clear();
+    if (map.size() != 0 || map.contains(2)) BANKER_FAIL("clear left entries.");
+}
+
 #endif //BANKER_ROBIN_HASH_TESTS_HPP
\ No newline at end of file
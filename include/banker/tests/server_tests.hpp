@@ -0,0 +1,248 @@
+/* ================================== *\
+ @file     server_tests.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_SERVER_TESTS_HPP
+#define BANKER_SERVER_TESTS_HPP
+
+#include <atomic>
+#include <chrono>
+
+#ifndef _WIN32
+    #include <sys/resource.h>   // getrlimit(), setrlimit()
+    #include <unistd.h>         // dup(), close()
+#endif
+
+#include "banker/core/networker/servers/event_loop.hpp"
+#include "banker/core/networker/servers/sharded_stream_server.hpp"
+#include "banker/tester/tester.hpp"
+
+BANKER_TEST_CASE(event_loop, idle_sleep, "Echoes through a single threaded event_loop, then checks an idle run_once blocks in poll and handles nothing.")
+{
+    using namespace banker::networker;
+    using namespace std::chrono;
+
+    event_loop loop{};
+    event_loop::callbacks cbs{};
+    cbs.on_receive = [](event_loop& l, const stable_id id)
+    {
+        stream_socket& client = *l.get(id);
+        const auto data = client.receive().contiguous();
+        l.send(id, std::vector<uint8_t>(data.begin(), data.end()));
+        client.receive().clear();
+    };
+    loop.set_callbacks(std::move(cbs));
+    if (!loop.listen("127.0.0.1", 0)) BANKER_FAIL("can't listen.");
+
+    banker::networker::socket client = stream_socket_core::new_client_socket("127.0.0.1", loop.port());
+    if (!client.is_valid()) BANKER_FAIL("can't connect.");
+
+    const auto deadline = steady_clock::now() + seconds(2);
+    while (loop.connection_count() == 0 && steady_clock::now() < deadline) loop.run_once(50);
+    if (loop.connection_count() != 1) BANKER_FAIL("connection wasn't accepted.");
+
+    const uint8_t msg[4] = {'p', 'i', 'n', 'g'};
+    if (client.send(msg, sizeof(msg)) != sizeof(msg)) BANKER_FAIL("can't send.");
+    while (!client.is_readable(0) && steady_clock::now() < deadline) loop.run_once(50);
+
+    uint8_t answer[4]{};
+    if (client.recv(answer, sizeof(answer)) != sizeof(answer) || answer[3] != 'g') BANKER_FAIL("bad echo.");
+
+    // nothing to do and no timers: the wait ends on the timeout, not in a spin.
+    const auto before = steady_clock::now();
+    size_t handled = 0;
+    for (int i = 0; i < 5; ++i) handled += loop.run_once(20);
+    const auto waited = duration_cast<milliseconds>(steady_clock::now() - before).count();
+
+    BANKER_MSG("5 idle rounds took ", waited, " ms, handled ", handled);
+    if (handled != 0) BANKER_FAIL("idle rounds reported ready sockets.");
+    if (waited < 80) BANKER_FAIL("idle rounds didn't block: ", waited, " ms.");
+}
+
+BANKER_TEST_CASE(event_loop, disconnect_in_callback, "Disconnects another client from inside on_receive, then echoes to the receiving client that got moved by it.")
+{
+    using namespace banker::networker;
+    using namespace std::chrono;
+
+    std::vector<stable_id> ids;
+    event_loop loop{};
+    event_loop::callbacks cbs{};
+    cbs.on_connect = [&](event_loop&, const stable_id id) { ids.push_back(id); };
+    cbs.on_receive = [&](event_loop& l, const stable_id id)
+    {
+        // the first client is removed, the last one (this one) takes its slot.
+        if (id != ids.front()) l.disconnect(ids.front());
+
+        stream_socket* client = l.get(id);
+        if (client == nullptr) return;
+        const auto data = client->receive().contiguous();
+        l.send(id, std::vector<uint8_t>(data.begin(), data.end()));
+        client->receive().clear();
+    };
+    loop.set_callbacks(std::move(cbs));
+    if (!loop.listen("127.0.0.1", 0)) BANKER_FAIL("can't listen.");
+
+    constexpr int client_count = 3;
+    std::vector<banker::networker::socket> clients;
+    const auto deadline = steady_clock::now() + seconds(2);
+    for (int i = 0; i < client_count; ++i)
+    {
+        // one at a time, so the ids follow the client order.
+        clients.push_back(stream_socket_core::new_client_socket("127.0.0.1", loop.port()));
+        if (!clients.back().is_valid()) BANKER_FAIL("client ", i, " can't connect.");
+        while (ids.size() < clients.size() && steady_clock::now() < deadline) loop.run_once(50);
+    }
+    if (loop.connection_count() != client_count) BANKER_FAIL("connections weren't accepted.");
+
+    auto& last = clients.back();
+    const uint8_t msg[4] = {'l', 'a', 's', 't'};
+    if (last.send(msg, sizeof(msg)) != sizeof(msg)) BANKER_FAIL("can't send.");
+    while (!last.is_readable(0) && steady_clock::now() < deadline) loop.run_once(50);
+
+    uint8_t answer[4]{};
+    if (last.recv(answer, sizeof(answer)) != sizeof(answer) || answer[0] != 'l' || answer[3] != 't')
+        BANKER_FAIL("bad echo after the disconnect.");
+
+    BANKER_MSG("connections left: ", loop.connection_count());
+    if (loop.connection_count() != client_count - 1) BANKER_FAIL("the other client wasn't disconnected.");
+    if (!clients.front().is_readable(500) || clients.front().recv(answer, sizeof(answer)) != 0)
+        BANKER_FAIL("the disconnected client's connection wasn't closed.");
+}
+
+#ifndef _WIN32
+BANKER_TEST_CASE(event_loop, accept_backoff, "Runs out of file descriptors with a connection pending and checks the loop backs off the listener instead of spinning, then accepts once descriptors are back.")
+{
+    using namespace banker::networker;
+    using namespace std::chrono;
+
+    event_loop loop{};
+    if (!loop.listen("127.0.0.1", 0)) BANKER_FAIL("can't listen.");
+
+    rlimit original{};
+    if (getrlimit(RLIMIT_NOFILE, &original) != 0) BANKER_FAIL("can't read the descriptor limit.");
+
+    // the lowest free descriptor is the only one left below the limit, the client takes it.
+    const int lowest = ::dup(0);
+    if (lowest < 0) BANKER_FAIL("can't dup.");
+    ::close(lowest);
+
+    rlimit tight = original;
+    tight.rlim_cur = static_cast<rlim_t>(lowest) + 1;
+    if (setrlimit(RLIMIT_NOFILE, &tight) != 0) BANKER_FAIL("can't lower the descriptor limit.");
+
+    banker::networker::socket client = stream_socket_core::new_client_socket("127.0.0.1", loop.port());
+    const bool connected = client.is_valid();
+
+    size_t handled = 0;
+    const auto until = steady_clock::now() + milliseconds(300);
+    while (connected && steady_clock::now() < until) handled += loop.run_once(50);
+    const size_t accepted_early = loop.connection_count();
+
+    setrlimit(RLIMIT_NOFILE, &original);
+    if (!connected) BANKER_FAIL("can't connect.");
+
+    BANKER_MSG("ready listener rounds in 300 ms: ", handled);
+    if (accepted_early != 0) BANKER_FAIL("accepted without a free descriptor.");
+    if (handled > 10) BANKER_FAIL("the loop kept waking up for the listener: ", handled, " rounds.");
+
+    const auto deadline = steady_clock::now() + seconds(2);
+    while (loop.connection_count() == 0 && steady_clock::now() < deadline) loop.run_once(50);
+    if (loop.connection_count() != 1) BANKER_FAIL("connection wasn't accepted after the backoff.");
+}
+#endif
+
+BANKER_TEST_CASE(sharded_server, echo, "Starts a 2 worker server and echoes data back to multiple clients.")
+{
+    using namespace banker::networker;
+
+    std::atomic<int> connected{0};
+    sharded_stream_server server{};
+    sharded_stream_server::callbacks cbs{};
+    cbs.on_connect = [&](sharded_stream_server::worker&, stable_id) { ++connected; };
+    cbs.on_receive = [](sharded_stream_server::worker& w, const stable_id id)
+    {
+        stream_socket& client = *w.get(id);
+        const auto data = client.receive().contiguous();
+        w.send(id, std::vector<uint8_t>(data.begin(), data.end()));
+        client.receive().clear();
+    };
+
+    if (!server.start("127.0.0.1", 0, cbs, 2)) BANKER_FAIL("can't start server.");
+    BANKER_MSG("workers: ", server.worker_count(), " port: ", server.port());
+
+    constexpr int client_count = 8;
+    std::vector<banker::networker::socket> clients;
+    for (int i = 0; i < client_count; ++i)
+    {
+        clients.push_back(stream_socket_core::new_client_socket("127.0.0.1", server.port()));
+        if (!clients.back().is_valid()) BANKER_FAIL("client ", i, " can't connect.");
+    }
+
+    for (int i = 0; i < client_count; ++i)
+    {
+        const uint8_t msg[4] = {'e', 'c', 'h', static_cast<uint8_t>('0' + i)};
+        if (clients[static_cast<size_t>(i)].send(msg, sizeof(msg)) != sizeof(msg)) BANKER_FAIL("can't send.");
+    }
+
+    for (int i = 0; i < client_count; ++i)
+    {
+        auto& client = clients[static_cast<size_t>(i)];
+        uint8_t answer[4]{};
+        if (!client.is_readable(2000)) BANKER_FAIL("client ", i, " got no answer.");
+        if (client.recv(answer, sizeof(answer)) != sizeof(answer)) BANKER_FAIL("client ", i, " got a short answer.");
+        if (answer[3] != static_cast<uint8_t>('0' + i)) BANKER_FAIL("client ", i, " got someone else's answer.");
+    }
+
+    BANKER_MSG("connected: ", connected.load());
+    server.stop();
+    if (connected.load() != client_count) BANKER_FAIL("wrong amount of connections: ", connected.load());
+}
+
+BANKER_TEST_CASE(sharded_server, timeouts, "Schedules a timer per connection and checks a silent client gets a tick and is then dropped for idling.")
+{
+    using namespace banker::networker;
+    using namespace std::chrono;
+
+    std::atomic<int> timed_out{0};
+    sharded_stream_server server{};
+    sharded_stream_server::callbacks cbs{};
+    cbs.on_connect = [](sharded_stream_server::worker& w, const stable_id id) { (void)w.schedule(milliseconds(50), id); };
+    cbs.on_timer = [](sharded_stream_server::worker& w, const uint64_t id)
+    {
+        const uint8_t tick[4] = {'t', 'i', 'c', 'k'};
+        w.send(id, std::vector<uint8_t>(tick, tick + 4));
+    };
+    cbs.on_timeout = [&](sharded_stream_server::worker&, stable_id, const sharded_stream_server::timeout_kind kind)
+    {
+        if (kind == sharded_stream_server::timeout_kind::idle) ++timed_out;
+    };
+
+    server.set_timeouts({milliseconds(300), milliseconds(0), milliseconds(0)});
+    if (!server.start("127.0.0.1", 0, cbs, 1)) BANKER_FAIL("can't start server.");
+
+    const auto start = steady_clock::now();
+    banker::networker::socket client = stream_socket_core::new_client_socket("127.0.0.1", server.port());
+    if (!client.is_valid()) BANKER_FAIL("can't connect.");
+
+    uint8_t answer[4]{};
+    if (!client.is_readable(2000) || client.recv(answer, sizeof(answer)) != sizeof(answer) || answer[0] != 't')
+        BANKER_FAIL("no timer tick.");
+
+    // the tick counts as activity, the idle timeout runs from there.
+    int r = -1;
+    for (int tries = 0; tries < 40 && r != 0; ++tries)
+        if (client.is_readable(100)) r = client.recv(answer, sizeof(answer));
+
+    const auto took = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    BANKER_MSG("dropped after ", took, " ms");
+    server.stop();
+
+    if (r != 0) BANKER_FAIL("idle client wasn't dropped.");
+    if (took < 300) BANKER_FAIL("dropped too early: ", took, " ms");
+    if (timed_out.load() != 1) BANKER_FAIL("on_timeout called ", timed_out.load(), " times.");
+}
+
+#endif //BANKER_SERVER_TESTS_HPP
@@ -0,0 +1,155 @@
+/* ================================== *\
+ @file     storage_tests.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_STORAGE_TESTS_HPP
+#define BANKER_STORAGE_TESTS_HPP
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "banker/core/networker/client_containers/dense_storage.hpp"
+#include "banker/core/networker/client_containers/soa_storage.hpp"
+#include "banker/core/networker/client_containers/stable_storage.hpp"
+#include "banker/tester/tester.hpp"
+
+BANKER_TEST_CASE(storage, stable_ids, "Adds and removes in a churn against a std::map and checks ids survive moves and stale ids die.")
+{
+    using banker::networker::stable_id;
+
+    banker::networker::stable_storage<std::string> storage{};
+    std::map<stable_id, std::string> reference{};
+    std::vector<stable_id> removed{};
+
+    banker::tester::test_rng next{12345};
+
+    for (int round = 0; round < 5000; ++round)
+    {
+        if (reference.empty() || next() % 3 != 0)
+        {
+            std::string value = "value " + std::to_string(round);
+            const stable_id id = storage.add(std::string(value));
+            if (reference.contains(id)) BANKER_FAIL("id ", id, " handed out twice.");
+            reference[id] = std::move(value);
+        }
+        else
+        {
+            auto it = reference.begin();
+            std::advance(it, static_cast<long>(next() % reference.size()));
+            storage.remove(it->first);
+            removed.push_back(it->first);
+            reference.erase(it);
+        }
+    }
+
+    if (storage.size() != reference.size()) BANKER_FAIL("size ", storage.size(), " != ", reference.size());
+
+    for (const auto& [id, value] : reference)
+    {
+        const std::string* item = storage.get(id);
+        if (item == nullptr || *item != value) BANKER_FAIL("id ", id, " lost its item.");
+    }
+
+    // slots get reused, but an old id must never resolve to the new item.
+    for (const stable_id id : removed)
+    {
+        if (storage.get(id) != nullptr) BANKER_FAIL("stale id ", id, " still resolves.");
+    }
+
+    for (size_t i = 0; i < storage.size(); ++i)
+    {
+        if (storage.get(storage.id_at(i)) != &storage.raw_at(i)) BANKER_FAIL("id_at(", i, ") doesn't point back.");
+    }
+
+    if (storage.get(banker::networker::invalid_id) != nullptr) BANKER_FAIL("invalid_id resolves.");
+
+    storage.clear();
+    if (!storage.empty() || storage.contains(reference.begin()->first)) BANKER_FAIL("clear() left items.");
+}
+
+BANKER_TEST_CASE(storage, soa_fields, "Mirrors a dense_storage churn in soa_storage, checks fields stay together, times a one field sweep (informational).")
+{
+    struct connection
+    {
+        int fd{0};
+        size_t pending{0};
+        std::string name{};
+        std::deque<std::vector<uint8_t>> queue{};
+    };
+
+    banker::networker::dense_storage<connection> dense{};
+    banker::networker::soa_storage<int, size_t, std::string, std::deque<std::vector<uint8_t>>> soa{};
+
+    banker::tester::test_rng next{777};
+
+    for (int round = 0; round < 20000; ++round)
+    {
+        if (dense.size() == 0 || next() % 4 != 0)
+        {
+            const int fd = round;
+            const size_t pending = next() % 4096;
+            std::string name = "conn " + std::to_string(round);
+
+            const size_t a = dense.add(connection{fd, pending, name, {}});
+            const size_t b = soa.add(fd, pending, std::move(name), {});
+            if (a != b) BANKER_FAIL("add returned ", b, " expected ", a);
+        }
+        else
+        {
+            const size_t index = next() % dense.size();
+            dense.remove(index);
+            soa.remove(index);
+        }
+    }
+
+    if (soa.size() != dense.size()) BANKER_FAIL("size ", soa.size(), " != ", dense.size());
+
+    for (size_t i = 0; i < dense.size(); ++i)
+    {
+        auto [fd, pending, name, queue] = soa[i];
+        if (fd != dense[i].fd || pending != dense[i].pending || name != dense[i].name)
+            BANKER_FAIL("item ", i, " came apart.");
+        if (&soa.get<2>(i) != &name) BANKER_FAIL("row doesn't reference the field arrays.");
+    }
+
+    // sweep only fd + pending, the way a readiness pass would.
+    auto time = [&](auto&& sweep)
+    {
+        return banker::tester::time_us([&]
+        {
+            uint64_t sum = 0;
+            for (int r = 0; r < 200; ++r) sum += sweep();
+            return sum;
+        });
+    };
+
+    const auto [dense_us, dense_sum] = time([&]
+    {
+        uint64_t s = 0;
+        for (const connection& c : dense) s += static_cast<uint64_t>(c.fd) + c.pending;
+        return s;
+    });
+
+    const auto [soa_us, soa_sum] = time([&]
+    {
+        uint64_t s = 0;
+        const auto fds = soa.field<0>();
+        const auto pending = soa.field<1>();
+        for (size_t i = 0; i < fds.size(); ++i) s += static_cast<uint64_t>(fds[i]) + pending[i];
+        return s;
+    });
+
+    BANKER_MSG(soa.size(), " items, dense sweep: ", dense_us, " us, soa sweep: ", soa_us, " us");
+    if (dense_sum != soa_sum) BANKER_FAIL("sweeps disagree.");
+
+    soa.remove(soa.size());
+    soa.clear();
+    if (!soa.empty()) BANKER_FAIL("clear() left items.");
+}
+
+#endif //BANKER_STORAGE_TESTS_HPP
@@ -0,0 +1,409 @@
+/* ================================== *\
+ @file     stream_tests.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_STREAM_TESTS_HPP
+#define BANKER_STREAM_TESTS_HPP
+
+#include <cstring>
+#include <vector>
+
+#include "banker/core/networker/core/packet/packet.hpp"
+#include "banker/core/networker/core/packet/packet_view.hpp"
+#include "banker/core/networker/core/stream_socket/stream_receive_buffer.hpp"
+#include "banker/core/networker/core/stream_socket/stream_socket.hpp"
+#include "banker/core/networker/core/stream_socket/stream_socket_core.hpp"
+#include "banker/tester/tester.hpp"
+#include "banker/tests/polling_tests.hpp"
+
+BANKER_TEST_CASE(stream, receive_buffer_wrap, "Fills, consumes and wraps the receive ring and checks the data stays in order.")
+{
+    banker::networker::stream_receive_buffer buffer{};
+
+    std::vector<uint8_t> data(1024 * 12);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 7);
+
+    buffer.append(data.data(), data.size());
+    const size_t capacity = buffer.capacity();
+    BANKER_MSG("capacity: ", capacity);
+
+    buffer.consume(1024 * 10);
+    if (buffer.size() != 1024 * 2) BANKER_FAIL("wrong size after consume: ", buffer.size());
+
+    // the free space now wraps around the end of the storage.
+    std::span<uint8_t> spans[2];
+    const size_t count = buffer.prepare(1024 * 8, spans);
+    if (buffer.capacity() != capacity) BANKER_FAIL("grew while there was enough free space.");
+    if (count != 2) BANKER_FAIL("free space should wrap, got ", count, " span(s).");
+
+    size_t written = 0;
+    for (size_t i = 0; i < count && written < 1024 * 8; ++i)
+    {
+        const size_t n = std::min(spans[i].size(), 1024 * 8 - written);
+        std::memcpy(spans[i].data(), data.data() + written, n);
+        written += n;
+    }
+    buffer.commit(written);
+
+    if (buffer.front().size() == buffer.size()) BANKER_FAIL("readable bytes should wrap.");
+
+    const auto view = buffer.contiguous();
+    if (view.size() != 1024 * 10) BANKER_FAIL("wrong contiguous size: ", view.size());
+    if (std::memcmp(view.data(), data.data() + 1024 * 10, 1024 * 2) != 0) BANKER_FAIL("old bytes got corrupted.");
+    if (std::memcmp(view.data() + 1024 * 2, data.data(), 1024 * 8) != 0) BANKER_FAIL("new bytes got corrupted.");
+
+    buffer.consume(view.size());
+    if (!buffer.empty()) BANKER_FAIL("buffer should be empty.");
+}
+
+BANKER_TEST_CASE(stream, flush_many_buffers, "Flushes more queued buffers than one writev takes and checks they arrive in order.")
+{
+    auto [server_side, client_side] = banker::tests::make_loopback_pair();
+    if (!server_side.is_valid() || !client_side.is_valid()) BANKER_FAIL("can't create loopback pair.");
+
+    using core = banker::networker::stream_socket_core;
+    core::send_state send{};
+    core::receive_state receive{};
+
+    const size_t buffer_count = banker::networker::socket::max_iovecs * 3 + 7;
+    for (size_t i = 0; i < buffer_count; ++i)
+        core::enqueue(send, std::vector<uint8_t>{static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8)});
+
+    if (send.iovecs.size() - send.iovec_head != send.out_buffers.size()) BANKER_FAIL("iovec cache out of sync.");
+
+    for (int i = 0; i < 100 && receive.receive_buffer.size() < buffer_count * 2; ++i)
+    {
+        banker::networker::tcp::request_result result;
+        (void)core::flush_out_buffer(client_side, send, &result);
+        if (result != banker::networker::tcp::request_result::ok) BANKER_FAIL("flush failed.");
+        if (send.iovecs.size() - send.iovec_head != send.out_buffers.size()) BANKER_FAIL("iovec cache out of sync.");
+
+        (void)server_side.is_readable(100);
+        (void)core::receive(server_side, receive, &result);
+        if (result != banker::networker::tcp::request_result::ok) BANKER_FAIL("receive failed.");
+    }
+
+    BANKER_MSG("received: ", receive.receive_buffer.size());
+    if (!send.out_buffers.empty()) BANKER_FAIL("buffers left: ", send.out_buffers.size());
+    if (receive.receive_buffer.size() != buffer_count * 2) BANKER_FAIL("wrong amount received.");
+
+    const auto view = receive.receive_buffer.contiguous();
+    for (size_t i = 0; i < buffer_count; ++i)
+    {
+        if (view[i * 2] != static_cast<uint8_t>(i) || view[i * 2 + 1] != static_cast<uint8_t>(i >> 8))
+            BANKER_FAIL("out of order at buffer ", i);
+    }
+}
+
+BANKER_TEST_CASE(stream, shared_broadcast, "Queues one shared payload on several sockets and checks it is sent without copies and freed after.")
+{
+    using core = banker::networker::stream_socket_core;
+    constexpr size_t pair_count = 4;
+
+    std::vector<std::pair<banker::networker::socket, banker::networker::socket>> pairs;
+    for (size_t i = 0; i < pair_count; ++i)
+    {
+        pairs.push_back(banker::tests::make_loopback_pair());
+        if (!pairs.back().first.is_valid() || !pairs.back().second.is_valid()) BANKER_FAIL("can't create loopback pair.");
+    }
+
+    std::vector<uint8_t> bytes(1024 * 4);
+    for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<uint8_t>(i * 3);
+
+    banker::shared_bytes payload = banker::make_shared_bytes(std::vector<uint8_t>(bytes));
+    const uint8_t* payload_data = payload->data();
+
+    std::vector<core::send_state> sends(pair_count);
+    for (auto& send : sends)
+    {
+        core::enqueue(send, payload);
+        if (send.out_buffers.front().data(0) != payload_data) BANKER_FAIL("shared payload got copied.");
+    }
+    BANKER_MSG("use count after enqueue: ", payload.use_count());
+    if (payload.use_count() != pair_count + 1) BANKER_FAIL("wrong use count: ", payload.use_count());
+
+    for (size_t i = 0; i < pair_count; ++i)
+    {
+        banker::networker::tcp::request_result result;
+        core::receive_state receive{};
+        for (int tries = 0; tries < 50 && receive.receive_buffer.size() < bytes.size(); ++tries)
+        {
+            (void)core::flush_out_buffer(pairs[i].second, sends[i], &result);
+            (void)pairs[i].first.is_readable(100);
+            (void)core::receive(pairs[i].first, receive, &result);
+        }
+
+        const auto view = receive.receive_buffer.contiguous();
+        if (view.size() != bytes.size() || std::memcmp(view.data(), bytes.data(), bytes.size()) != 0)
+            BANKER_FAIL("socket ", i, " received wrong data.");
+    }
+
+    BANKER_MSG("use count after flush: ", payload.use_count());
+    if (payload.use_count() != 1) BANKER_FAIL("sent buffers still reference the payload.");
+}
+
+BANKER_TEST_CASE(stream, packet_scatter_gather, "Queues packets as header + payload without serializing them and reads the frames back.")
+{
+    using core = banker::networker::stream_socket_core;
+    using banker::networker::packet;
+
+    auto [client, server] = banker::tests::make_loopback_pair();
+    if (!client.is_valid() || !server.is_valid()) BANKER_FAIL("can't create loopback pair.");
+
+    core::send_state send{};
+
+    packet single{};
+    single.write(std::string("single"));
+    single.write(std::vector<uint32_t>(512, 7));
+    const size_t single_size = single.get_data().size();
+    const uint8_t* single_data = single.get_data().data();
+
+    core::enqueue_packet(send, std::move(single));
+    if (send.out_buffers.size() != 2) BANKER_FAIL("expected header + payload, got ", send.out_buffers.size(), " buffer(s).");
+    if (send.out_buffers.back().data(0) != single_data) BANKER_FAIL("payload got copied.");
+    if (!single.get_data().empty()) BANKER_FAIL("packet wasn't emptied.");
+
+    packet merged[2]{};
+    merged[0].write(uint64_t{42});
+    merged[1].write(std::string("merged"));
+    core::enqueue_packets(send, std::span<packet>(merged));
+    if (send.out_buffers.size() != 5) BANKER_FAIL("expected one header for the merged packets, got ", send.out_buffers.size(), " buffer(s).");
+
+    banker::networker::tcp::request_result result;
+    core::receive_state receive{};
+    const size_t expected = 2 * banker::networker::frame_reader::header_size + single_size + sizeof(uint64_t) + 4 + 6;
+    for (int tries = 0; tries < 50 && receive.receive_buffer.size() < expected; ++tries)
+    {
+        (void)core::flush_out_buffer(server, send, &result);
+        (void)client.is_readable(100);
+        (void)core::receive(client, receive, &result);
+    }
+    if (!send.out_buffers.empty()) BANKER_FAIL("send queue not drained.");
+
+    const auto bytes = receive.receive_buffer.contiguous();
+    banker::networker::frame_reader frames{bytes};
+
+    banker::networker::packet_view frame{};
+    if (!frames.next(frame)) BANKER_FAIL("missing first frame.");
+    if (frame.read<std::string_view>() != "single") BANKER_FAIL("first frame corrupted.");
+    if (frame.read<std::vector<uint32_t>>() != std::vector<uint32_t>(512, 7)) BANKER_FAIL("first frame corrupted.");
+
+    if (!frames.next(frame)) BANKER_FAIL("missing merged frame.");
+    if (frame.read<uint64_t>() != 42 || frame.read<std::string_view>() != "merged") BANKER_FAIL("merged frame corrupted.");
+    if (frames.consumed() != expected) BANKER_FAIL("unexpected trailing bytes.");
+}
+
+BANKER_TEST_CASE(stream, inline_copy, "Copies a header that fits inline and one that doesn't, checks neither is cut short.")
+{
+    using banker::networker::stream_transmit_buffer;
+
+    std::vector<uint8_t> bytes(64);
+    for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<uint8_t>(i);
+
+    for (const size_t size : {size_t{0}, size_t{4}, banker::variant_buffer::inline_capacity, size_t{21}, bytes.size()})
+    {
+        const auto buffer = stream_transmit_buffer::inline_copy(bytes.data(), size);
+        if (buffer.size(0) != size) BANKER_FAIL("copy of ", size, " bytes holds ", buffer.size(0));
+        if (size > 0 && std::memcmp(buffer.data(0), bytes.data(), size) != 0) BANKER_FAIL("copy of ", size, " bytes corrupted.");
+    }
+}
+
+BANKER_TEST_CASE(stream, send_backpressure, "Checks the watermarks pause and resume, reject refuses, and drop_oldest only drops whole unsent frames.")
+{
+    using core = banker::networker::stream_socket_core;
+    using banker::networker::packet;
+
+    auto [client, server] = banker::tests::make_loopback_pair();
+    if (!client.is_valid() || !server.is_valid()) BANKER_FAIL("can't create loopback pair.");
+
+    core::send_state send{};
+    send.limits = core::send_limits{1000, 200, 2000, core::overflow_policy::reject};
+
+    size_t queued = 0;
+    core::enqueue_result r = core::enqueue_result::queued;
+    while (core::was_queued(r = core::enqueue(send, std::vector<uint8_t>(100, 1))))
+    {
+        ++queued;
+        if ((send.queued_bytes >= 1000) != (r == core::enqueue_result::paused))
+            BANKER_FAIL("paused at ", send.queued_bytes, " bytes.");
+    }
+    BANKER_MSG("queued ", queued, " buffers before ", static_cast<int>(r));
+    if (r != core::enqueue_result::rejected || send.queued_bytes != 2000) BANKER_FAIL("reject didn't cap the queue.");
+
+    banker::networker::tcp::request_result result;
+    core::receive_state receive{};
+    for (int tries = 0; tries < 50 && send.paused; ++tries)
+    {
+        (void)core::flush_out_buffer(server, send, &result);
+        (void)client.is_readable(100);
+        (void)core::receive(client, receive, &result);
+    }
+    if (send.paused || send.queued_bytes > 200) BANKER_FAIL("didn't resume at the low watermark.");
+    core::clear_send(send);
+    receive.receive_buffer.consume(receive.receive_buffer.size());
+
+    // disconnect.
+    send.limits.policy = core::overflow_policy::disconnect;
+    send.limits.max_queued = 150;
+    (void)core::enqueue(send, std::vector<uint8_t>(100, 2));
+    if (core::enqueue(send, std::vector<uint8_t>(100, 2)) != core::enqueue_result::overflow || !send.overflowed)
+        BANKER_FAIL("disconnect policy didn't trip.");
+    core::clear_send(send);
+
+    // drop_oldest: the first frame is partly sent and must survive whole.
+    core::send_state drop{};
+    drop.limits = core::send_limits{0, 0, 3000, core::overflow_policy::drop_oldest};
+
+    auto make = [](const uint32_t tag)
+    {
+        packet p{};
+        p.write(tag);
+        p.write(std::vector<uint8_t>(900, static_cast<uint8_t>(tag)));
+        return p;
+    };
+
+    (void)core::enqueue_packet(drop, make(0));
+    const size_t frame_size = drop.queued_bytes;
+
+    // pretend a few header bytes went out, by sending them for real.
+    std::vector<uint8_t> head(drop.out_buffers.front().data(0), drop.out_buffers.front().data(0) + 3);
+    if (server.send(head.data(), head.size()) != 3) BANKER_FAIL("can't send the partial header.");
+    (void)core::consume_sent(drop, 3);
+
+    for (uint32_t tag = 1; tag <= 4; ++tag)
+        if (!core::was_queued(core::enqueue_packet(drop, make(tag)))) BANKER_FAIL("frame ", tag, " refused.");
+
+    BANKER_MSG("dropped ", drop.dropped_frames, " frame(s), queued ", drop.queued_bytes);
+    if (drop.dropped_frames != 2) BANKER_FAIL("expected 2 dropped frames, got ", drop.dropped_frames);
+    if (drop.queued_bytes > 3000) BANKER_FAIL("over max_queued.");
+    if (drop.iovecs.size() - drop.iovec_head != drop.out_buffers.size()) BANKER_FAIL("iovec cache out of sync.");
+
+    const size_t expected = frame_size + 2 * frame_size;
+    for (int tries = 0; tries < 50 && receive.receive_buffer.size() < expected; ++tries)
+    {
+        (void)core::flush_out_buffer(server, drop, &result);
+        (void)client.is_readable(100);
+        (void)core::receive(client, receive, &result);
+    }
+
+    banker::networker::frame_reader frames{receive.receive_buffer.contiguous()};
+    banker::networker::packet_view frame{};
+    for (const uint32_t tag : {0u, 3u, 4u})
+    {
+        if (!frames.next(frame)) BANKER_FAIL("missing frame ", tag);
+        if (frame.read<uint32_t>() != tag) BANKER_FAIL("expected frame ", tag);
+        if (frame.read<std::vector<uint8_t>>() != std::vector<uint8_t>(900, static_cast<uint8_t>(tag)))
+            BANKER_FAIL("frame ", tag, " corrupted.");
+    }
+    if (frames.consumed() != expected) BANKER_FAIL("unexpected trailing bytes.");
+}
+
+BANKER_TEST_CASE(stream, sealed_frames, "Sends encrypted frames between two stream_sockets and checks they are encrypted in place and tampering is caught.")
+{
+    using banker::networker::crypto_session;
+    using banker::networker::crypto_stream_core;
+    using open_result = crypto_stream_core::open_result;
+
+    auto [a, b] = banker::tests::make_loopback_pair();
+    if (!a.is_valid() || !b.is_valid()) BANKER_FAIL("can't create loopback pair.");
+
+    banker::networker::stream_socket client{std::move(a)};
+    banker::networker::stream_socket server{std::move(b)};
+
+    banker::crypter::key shared{};
+    banker::crypto_rng::get(shared);
+    client.set_session(crypto_session{shared, crypto_session::role::initiator});
+    server.set_session(crypto_session{shared, crypto_session::role::responder});
+
+    // the payload is encrypted where it sits, the packet's storage is what gets sent.
+    {
+        banker::networker::stream_socket_core::send_state send{};
+        crypto_session session{shared, crypto_session::role::responder};
+
+        banker::networker::packet pkt{};
+        pkt.write(std::string("in place"));
+        const uint8_t* storage = pkt.get_data().data();
+
+        crypto_stream_core::enqueue_sealed(send, session, std::move(pkt));
+        if (send.out_buffers.size() != 2 || send.out_buffers.back().data(0) != storage)
+            BANKER_FAIL("payload got copied.");
+    }
+
+    // drop_oldest never drops a sealed frame (the peer's ratchet would fall behind), it overflows instead.
+    {
+        using core = banker::networker::stream_socket_core;
+        core::send_state send{};
+        send.limits = core::send_limits{0, 0, 1000, core::overflow_policy::drop_oldest};
+        crypto_session session{shared, crypto_session::role::initiator};
+
+        const std::vector<uint8_t> payload(100, 3);
+        core::enqueue_result r = core::enqueue_result::queued;
+        size_t queued = 0;
+        while (core::was_queued(r = crypto_stream_core::enqueue_sealed(send, session, payload))) ++queued;
+
+        BANKER_MSG("queued ", queued, " sealed frames before ", static_cast<int>(r));
+        if (r != core::enqueue_result::overflow || !send.overflowed) BANKER_FAIL("sealed overflow didn't disconnect.");
+        if (send.dropped_frames != 0 || send.out_buffers.size() != queued) BANKER_FAIL("a queued sealed frame got dropped.");
+        if (session.sealed() != queued) BANKER_FAIL("a refused frame used up a nonce.");
+    }
+
+    banker::networker::packet pkt{};
+    pkt.write(uint32_t{7});
+    pkt.write(std::string("sealed packet"));
+    client.enqueue_sealed(std::move(pkt));
+
+    const std::string text = "sealed span";
+    client.enqueue_sealed(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+
+    banker::networker::packet last{};
+    last.write(uint64_t{99});
+    client.enqueue_sealed(std::move(last));
+
+    const size_t expected = 3 * crypto_stream_core::overhead + (4 + 4 + 13) + text.size() + 8;
+    for (int tries = 0; tries < 50 && server.receive().size() < expected; ++tries)
+    {
+        (void)client.tick(false, true);
+        (void)server.raw_socket().is_readable(100);
+        (void)server.tick(true, false);
+    }
+    if (server.receive().size() != expected) BANKER_FAIL("received ", server.receive().size(), " of ", expected, " bytes.");
+
+    banker::networker::packet_view view{};
+    if (server.open_sealed(view) != open_result::ok) BANKER_FAIL("first frame didn't open.");
+    if (view.read<uint32_t>() != 7 || view.read<std::string_view>() != "sealed packet") BANKER_FAIL("first frame corrupted.");
+
+    if (server.open_sealed(view) != open_result::ok) BANKER_FAIL("second frame didn't open.");
+    const auto plain = view.get_data();
+    if (std::string_view(reinterpret_cast<const char*>(plain.data()), plain.size()) != text) BANKER_FAIL("second frame corrupted.");
+
+    // flip a bit of the last frame's cipher text (the second frame is still at the front).
+    auto bytes = server.receive().contiguous();
+    const size_t last_frame = crypto_stream_core::overhead + text.size();
+    bytes[last_frame + crypto_stream_core::overhead] ^= 0x01;
+    if (server.open_sealed(view) != open_result::forged) BANKER_FAIL("tampered frame opened.");
+    if (server.session().is_valid()) BANKER_FAIL("session still valid after a forged frame.");
+
+    // the broken session refuses to send, nothing gets queued under the wiped key.
+    using enqueue_result = banker::networker::stream_socket::enqueue_result;
+    const uint8_t reply[4] = {'n', 'o', 'p', 'e'};
+    if (server.enqueue_sealed(std::span<const uint8_t>(reply, sizeof(reply))) != enqueue_result::rejected)
+        BANKER_FAIL("sealed on a session broken by a forged frame.");
+
+    banker::networker::packet refused{};
+    refused.write(uint32_t{1});
+    if (server.enqueue_sealed(std::move(refused)) != enqueue_result::rejected)
+        BANKER_FAIL("sealed a packet on a broken session.");
+    if (server.has_pending_send() || server.queued_bytes() != 0) BANKER_FAIL("a refused frame got queued.");
+
+    // same for a socket that never had set_session().
+    auto [c, d] = banker::tests::make_loopback_pair();
+    banker::networker::stream_socket unset{std::move(c)};
+    if (unset.enqueue_sealed(std::span<const uint8_t>(reply, sizeof(reply))) != enqueue_result::rejected)
+        BANKER_FAIL("sealed without a session.");
+    if (unset.has_pending_send()) BANKER_FAIL("frame queued without a session.");
+}
+
+#endif //BANKER_STREAM_TESTS_HPP
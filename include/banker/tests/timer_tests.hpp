@@ -0,0 +1,160 @@
+/* ================================== *\
+ @file     timer_tests.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_TIMER_TESTS_HPP
+#define BANKER_TIMER_TESTS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include "banker/common/time/timer_wheel.hpp"
+#include "banker/tester/tester.hpp"
+
+BANKER_TEST_CASE(timer_wheel, expiry_order, "Schedules timers over every level and checks each fires in the advance that passes its tick, never early.")
+{
+    using banker::time::timer_wheel;
+    using namespace std::chrono;
+
+    const auto start = timer_wheel::clock::time_point{} + hours(1);
+    timer_wheel wheel{milliseconds(1), start};
+
+    banker::tester::test_rng next{99};
+
+    // user_data = expiry in ms, spread over level 0 (< 256) up to level 3 (> 2^24).
+    std::map<banker::time::timer_id, uint64_t> pending{};
+    for (int i = 0; i < 4000; ++i)
+    {
+        const uint64_t scale[] = {200, 60000, 10000000, 60000000};
+        const uint64_t delay = 1 + next() % scale[i % 4];
+        pending[wheel.schedule(milliseconds(delay), delay, start)] = delay;
+    }
+
+    uint64_t previous = 0;
+    uint64_t now = 0;
+    size_t fired = 0;
+    while (!wheel.empty())
+    {
+        // step sizes vary from a single tick to a large jump.
+        now += 1 + next() % (next() % 4 == 0 ? 5000000 : 300);
+
+        // everything up to 'previous' fired, so nothing is due: wait > 0, and never past the next expiry.
+        const int timeout = wheel.poll_timeout(start + milliseconds(previous));
+        if (timeout < 0) BANKER_FAIL("poll_timeout says nothing is scheduled.");
+        if (timeout == 0) BANKER_FAIL("poll_timeout is 0 at ", previous, " ms with nothing due.");
+
+        uint64_t soonest = ~uint64_t{0};
+        for (const auto& [id, expires] : pending) soonest = std::min(soonest, expires);
+        if (previous + static_cast<uint64_t>(timeout) > soonest)
+            BANKER_FAIL("poll_timeout ", timeout, " at ", previous, " ms overshoots the timer at ", soonest, " ms.");
+
+        fired += wheel.advance(start + milliseconds(now), [&](const banker::time::timer_id id, const uint64_t expires)
+        {
+            if (expires <= previous || expires > now) BANKER_FAIL("timer for ", expires, " fired in (", previous, ", ", now, "].");
+            if (pending.erase(id) != 1) BANKER_FAIL("unknown or repeated id fired.");
+        });
+        previous = now;
+    }
+
+    BANKER_MSG("fired ", fired, " timers up to ", now, " ms");
+    if (fired != 4000 || !pending.empty()) BANKER_FAIL("timers lost: ", pending.size());
+}
+
+BANKER_TEST_CASE(timer_wheel, cancel_and_reschedule, "Cancels, reschedules and cancels from inside a callback, checks poll_timeout follows the next expiry.")
+{
+    using banker::time::timer_wheel;
+    using namespace std::chrono;
+
+    const auto start = timer_wheel::clock::time_point{} + hours(1);
+    timer_wheel wheel{milliseconds(10), start};
+
+    if (wheel.poll_timeout(start) != -1 || wheel.poll_timeout(start, 250) != 250) BANKER_FAIL("empty wheel should wait.");
+
+    const auto a = wheel.schedule(milliseconds(500), 1, start);
+    const auto b = wheel.schedule(milliseconds(505), 2, start);     // rounds up to 510.
+    const auto c = wheel.schedule(seconds(100), 3, start);
+
+    const int timeout = wheel.poll_timeout(start);
+    BANKER_MSG("poll_timeout with a 500 ms timer: ", timeout);
+    if (timeout != 500) BANKER_FAIL("expected 500 ms, got ", timeout);
+
+    if (!wheel.cancel(a) || wheel.cancel(a) || wheel.contains(a)) BANKER_FAIL("cancel went wrong.");
+    if (wheel.poll_timeout(start) != 510) BANKER_FAIL("expected 510 ms after cancel, got ", wheel.poll_timeout(start));
+
+    // idle timeout style: pushed back on activity, the id stays valid.
+    if (!wheel.reschedule(b, seconds(2), start + milliseconds(400))) BANKER_FAIL("reschedule failed.");
+    if (wheel.advance(start + milliseconds(2000), [](auto, auto) {}) != 0) BANKER_FAIL("rescheduled timer fired early.");
+
+    std::vector<uint64_t> order{};
+    const auto d = wheel.schedule(milliseconds(400), 4, start + milliseconds(2000));
+    wheel.advance(start + milliseconds(2400), [&](const banker::time::timer_id, const uint64_t data)
+    {
+        order.push_back(data);
+        if (data == 2) wheel.cancel(d);     // both are due in this slot, cancel the other one.
+        if (data == 4) wheel.cancel(b);
+    });
+    if (order.size() != 1) BANKER_FAIL("a timer cancelled from a callback still fired.");
+
+    // the 100 s timer sits in a higher level, poll_timeout may wake early but never late.
+    const auto now = start + milliseconds(2400);
+    const int far = wheel.poll_timeout(now);
+    BANKER_MSG("poll_timeout with only the 100 s timer: ", far);
+    if (far <= 0 || far > 97600) BANKER_FAIL("bad far timeout: ", far);
+
+    bool fired = false;
+    wheel.advance(start + milliseconds(99990), [&](auto, auto) { fired = true; });
+    if (fired) BANKER_FAIL("fired early.");
+    wheel.advance(start + seconds(100), [&](const banker::time::timer_id id, auto) { fired = id == c; });
+    if (!fired || !wheel.empty()) BANKER_FAIL("100 s timer didn't fire on time.");
+
+    // a freed node is reused, the old id must not resolve.
+    const auto e = wheel.schedule(milliseconds(10), 5, start + seconds(100));
+    if (wheel.contains(c) || !wheel.contains(e)) BANKER_FAIL("stale id resolves.");
+}
+
+BANKER_TEST_CASE(timer_wheel, wrapped_slot_wait, "Schedules timers that wrap onto the current slot of a higher level and checks poll_timeout never drops to 0 before they are due.")
+{
+    using banker::time::timer_wheel;
+    using namespace std::chrono;
+
+    const auto start = timer_wheel::clock::time_point{} + hours(1);
+
+    // level 1 (65.5 s from tick 200) and level 2 (2^24 - 500 ms), both land in their level's current slot.
+    const uint64_t cases[][3] = {
+        {200, 65500, 97},
+        {200, (uint64_t{1} << 24) - 500, 4099},
+    };
+
+    for (const auto& [from, delay, step] : cases)
+    {
+        timer_wheel wheel{milliseconds(1), start};
+        wheel.advance(start + milliseconds(from), [](auto, auto) {});
+        (void)wheel.schedule(milliseconds(delay), 0, start + milliseconds(from));
+
+        const uint64_t due = from + delay;
+        size_t polls = 0;
+        bool fired = false;
+        for (uint64_t now = from; !fired; now = std::min(now + step, due))
+        {
+            if (wheel.advance(start + milliseconds(now), [](auto, auto) {}) != 0)
+            {
+                if (now != due) BANKER_FAIL("timer due at ", due, " fired at ", now);
+                fired = true;
+                continue;
+            }
+
+            const int timeout = wheel.poll_timeout(start + milliseconds(now));
+            ++polls;
+            if (timeout <= 0) BANKER_FAIL("poll_timeout ", timeout, " at ", now, " ms, timer due at ", due, " ms.");
+            if (now + static_cast<uint64_t>(timeout) > due) BANKER_FAIL("poll_timeout overshoots at ", now, " ms.");
+        }
+        BANKER_MSG(delay, " ms timer: ", polls, " waits, none zero");
+    }
+}
+
+#endif //BANKER_TIMER_TESTS_HPP
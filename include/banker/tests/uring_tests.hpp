@@ -0,0 +1,77 @@
+/* ================================== *\
+ @file     uring_tests.hpp
+ @project  banker
+ @author   moosm
+ @date     10/17/2026
+*\ ================================== */
+
+#ifndef BANKER_URING_TESTS_HPP
+#define BANKER_URING_TESTS_HPP
+
+#include "banker/core/networker/core/stream_socket/stream_uring_engine.hpp"
+#include "banker/tester/tester.hpp"
+
+#ifdef BANKER_PLATFORM_LINUX
+
+BANKER_TEST_CASE(uring, echo, "Accepts, receives and answers a loopback client through the io_uring engine.")
+{
+    using engine_t = banker::networker::stream_uring_engine;
+    engine_t engine{};
+    if (!engine.is_valid())
+    {
+        BANKER_MSG("io_uring is not available, skipping.");
+        return;
+    }
+
+    banker::networker::socket listener =
+        banker::networker::stream_socket_core::new_server_socket("127.0.0.1", 0);
+    const uint16_t port = listener.get_local_info().port;
+    if (!engine.listen(std::move(listener))) BANKER_FAIL("can't listen.");
+
+    banker::networker::socket client =
+        banker::networker::stream_socket_core::new_client_socket("127.0.0.1", port);
+    if (!client.is_valid()) BANKER_FAIL("can't connect.");
+
+    const char msg[] = "ping";
+    if (client.send(msg, sizeof(msg)) != sizeof(msg)) BANKER_FAIL("can't send.");
+
+    engine_t::connection_id id = engine_t::invalid_connection;
+    size_t received = 0;
+    for (int i = 0; i < 50 && received < sizeof(msg); ++i)
+    {
+        engine.tick(20);
+        engine_t::completion c;
+        while (engine.next_completion(c))
+        {
+            if (c.type == engine_t::event::accepted) id = c.id;
+            if (c.type == engine_t::event::received) received += c.bytes;
+        }
+    }
+    BANKER_MSG("id: ", id, " received: ", received);
+    if (id == engine_t::invalid_connection) BANKER_FAIL("nothing got accepted.");
+    if (received != sizeof(msg)) BANKER_FAIL("wrong amount received: ", received);
+    if (std::memcmp(engine.receive(id).contiguous().data(), msg, sizeof(msg)) != 0) BANKER_FAIL("wrong data received.");
+
+    engine.enqueue(id, std::vector<uint8_t>{'p', 'o', 'n', 'g'});
+    size_t sent = 0;
+    for (int i = 0; i < 50 && sent < 4; ++i)
+    {
+        engine.tick(20);
+        engine_t::completion c;
+        while (engine.next_completion(c))
+            if (c.type == engine_t::event::sent) sent += c.bytes;
+    }
+    if (sent != 4) BANKER_FAIL("wrong amount sent: ", sent);
+
+    char answer[4]{};
+    if (!client.is_readable(1000) || client.recv(answer, sizeof(answer)) != 4) BANKER_FAIL("client got no answer.");
+    if (std::memcmp(answer, "pong", 4) != 0) BANKER_FAIL("wrong answer.");
+
+    engine.close(id);
+    for (int i = 0; i < 10 && engine.contains(id); ++i) engine.tick(20);
+    if (engine.contains(id)) BANKER_FAIL("connection didn't get released.");
+}
+
+#endif // BANKER_PLATFORM_LINUX
+
+#endif //BANKER_URING_TESTS_HPP
@@ -12,11 +12,11 @@
 #include <filesystem>
 #include <cstdint>
 #include <fstream>
-#include <list>
 #include <string>
 #include <vector>
 
 #include "banker/core/networker/core/stream_socket/stream_socket.hpp"
+#include "banker/core/networker/servers/event_loop.hpp"
 
 namespace fs = std::filesystem;
 
@@ -377,49 +377,51 @@ inline std::string http_process(const std::string& input)
     return response.str();
 }
 
-[[noreturn]] inline void http_server(const bool log)
+inline void http_server(const bool log)
 {
-    banker::networker::stream_socket::acceptor server("0.0.0.0", 0);
-    uint16_t port = server.raw_socket().get_local_info().port;
-    std::cout << "open on: http://127.0.0.1" << ":" << port << std::endl;
+    using banker::networker::event_loop;
+    using banker::networker::stable_id;
+    using banker::networker::stream_socket;
 
-    std::list<banker::networker::stream_socket> clients;
-    while (true)
+    event_loop loop{};
+    if (!loop.listen("0.0.0.0", 0))
     {
-        while (server.touch())
-        {
-            banker::networker::stream_socket new_client = server.accept();
-            if (new_client.is_valid())
-            {
-                if (log) std::cout << "[SERVER] new client connected. client("<<new_client.raw_socket().to_fd()<<")" << std::endl;
-                clients.push_back(std::move(new_client));
-            }
-        }
+        std::cerr << "[SERVER] can't listen" << std::endl;
+        return;
+    }
+    std::cout << "open on: http://127.0.0.1" << ":" << loop.port() << std::endl;
 
-        for (auto it = clients.begin(); it != clients.end(); )
+    event_loop::callbacks callbacks{};
+    callbacks.on_connect = [log](event_loop& l, const stable_id id)
+    {
+        if (log) std::cout << "[SERVER] new client connected. client("<<l.get(id)->raw_socket().to_fd()<<")" << std::endl;
+    };
+    callbacks.on_receive = [log](event_loop& l, const stable_id id)
+    {
+        while (true)
         {
-            auto& client = *it;
-            banker::networker::tcp::request_result result;
-            auto r = client.tick(true, true, &result);
-            auto& buf = client.receive();
+            // looked up every request, send() may drop the connection.
+            stream_socket* client = l.get(id);
+            if (client == nullptr) return;
+
+            auto buf = client->receive().contiguous();
             auto pos = std::search(buf.begin(), buf.end(), "\r\n\r\n", "\r\n\r\n"+4);
-            if (pos != buf.end())
-            {
-                std::string request(buf.begin(), pos+4);
-                buf.erase(buf.begin(), pos+4);
-                if (log) std::cout << "[SERVER] client("<<client.raw_socket().to_fd()<<") :" << request << std::endl;
-                std::string response = http_process(request);
-                client.enqueue({response.begin(), response.end()});
-            }
-            if (result != banker::networker::tcp::request_result::ok)
-            {
-                if (log) std::cout << "[SERVER] client("<<client.raw_socket().to_fd()<<") disconnected." << std::endl;
-                it = clients.erase(it);
-                continue;
-            }
-            ++it;
+            if (pos == buf.end()) return;
+
+            std::string request(buf.begin(), pos+4);
+            client->receive().consume(static_cast<size_t>(pos + 4 - buf.begin()));
+            if (log) std::cout << "[SERVER] client("<<client->raw_socket().to_fd()<<") :" << request << std::endl;
+            std::string response = http_process(request);
+            l.send(id, std::vector<uint8_t>{response.begin(), response.end()});
         }
-    }
+    };
+    callbacks.on_disconnect = [log](event_loop& l, const stable_id id)
+    {
+        if (log) std::cout << "[SERVER] client("<<l.get(id)->raw_socket().to_fd()<<") disconnected." << std::endl;
+    };
+    loop.set_callbacks(std::move(callbacks));
+
+    loop.run();
 }
 
 #endif //BANKER_HTTP_SERVER_HPP
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include <fstream>
 #include <iostream>
-#include <list>
 #include <thread>
 #include <filesystem>
 #include <sstream>
@@ -22,54 +21,87 @@
 #include "banker/core/networker/core/stream_socket/stream_socket_core.hpp"
 #include "banker/tester/tester.hpp"
 
+#include "banker/tests/buffer_pool_tests.hpp"
 #include "banker/tests/encryption_tests.hpp"
 #include "banker/tests/handshake_tests.hpp"
 #include "banker/tests/packet_tests.hpp"
+#include "banker/tests/polling_tests.hpp"
 #include "banker/tests/robin_hash_tests.hpp"
+#include "banker/tests/server_tests.hpp"
+#include "banker/tests/storage_tests.hpp"
+#include "banker/tests/stream_tests.hpp"
+#include "banker/tests/timer_tests.hpp"
+#include "banker/tests/uring_tests.hpp"
 
 #include "http_server.hpp"
 #include "banker/core/networker/core/socket/polling.hpp"
+#include "banker/core/networker/servers/event_loop.hpp"
+#include "banker/core/networker/servers/sharded_stream_server.hpp"
 
 using namespace banker;
 namespace fs = std::filesystem;
 
-void log_char_vector(const std::vector<uint8_t>& vec)
+void log_char_vector(const std::span<const uint8_t> vec)
 {
     for (const auto& i : vec) std::cout << static_cast<char>(i);
 }
 
 void server()
 {
-    networker::stream_socket::acceptor server("0.0.0.0",8080);
-    std::list<networker::stream_socket> clients;
-    while (true)
+    networker::event_loop::callbacks callbacks{};
+    callbacks.on_receive = [](networker::event_loop& loop, const networker::stable_id id)
     {
-        while (server.touch())
-        {
-            networker::stream_socket new_client = server.accept();
-            if (new_client.is_valid())
-                clients.push_back(std::move(new_client));
-        }
-        for (auto it = clients.begin(); it != clients.end(); )
-        {
-            auto& client = *it;
-            banker::networker::tcp::request_result result;
-            const auto r = client.tick(true, false, &result);
-            if (result != banker::networker::tcp::request_result::ok)
-            {
-                std::cout << "[server] client disconnected\n";
-                it = clients.erase(it);
-                continue;
-            }
-            if (r != 0)
-            {
-                std::cout << "[server] client("<<&it<<") : ";
-                log_char_vector(client.receive());
-                std::cout << "\n";
-                client.receive().clear();
-            }
-        }
+        networker::stream_socket& client = *loop.get(id);
+        std::cout << "[server] client(" << id << ") : ";
+        log_char_vector(client.receive().contiguous());
+        std::cout << "\n";
+        client.receive().clear();
+    };
+    callbacks.on_disconnect = [](networker::event_loop&, const networker::stable_id)
+    {
+        std::cout << "[server] client disconnected\n";
+    };
+
+    networker::event_loop loop{};
+    loop.set_callbacks(std::move(callbacks));
+    if (!loop.listen("0.0.0.0", 8080))
+    {
+        std::cerr << "[server] can't start\n";
+        return;
     }
+    loop.run();
+}
+
+void sharded_server()
+{
+    networker::sharded_stream_server::callbacks callbacks{};
+    callbacks.on_receive = [](networker::sharded_stream_server::worker& worker, const networker::stable_id id)
+    {
+        networker::stream_socket& client = *worker.get(id);
+        std::stringstream ss;
+        ss << "[server:" << worker.index() << "] client(" << id << ") : ";
+        for (const auto& i : client.receive().contiguous()) ss << static_cast<char>(i);
+        ss << "\n";
+        std::cout << ss.str();
+        client.receive().clear();
+    };
+    callbacks.on_disconnect = [](
+        networker::sharded_stream_server::worker& worker,
+        const networker::stable_id)
+    {
+        std::cout << "[server:" << worker.index() << "] client disconnected\n";
+    };
+
+    networker::sharded_stream_server server{};
+    if (!server.start("0.0.0.0", 8080, callbacks))
+    {
+        std::cerr << "[server] can't start\n";
+        return;
+    }
+
+    std::cout << "[server] running " << server.worker_count() << " workers\n";
+    while (server.is_running())
+        std::this_thread::sleep_for(std::chrono::seconds(1));
 }
 
 void client()
@@ -90,31 +122,37 @@ void client()
 
     while (true)
     {
-        pg.poll(200);
-        networker::poll_group::result result;
-        if ( pg.next_result(result) == -1 )
+        if ( pg.poll(200) < 0 )
         {
-            std::cout << "[client] error happened (no poll result)\n";
+            std::cout << "[client] error happened (poll failed)\n";
             break;
         }
 
-        if (result.error)
+        networker::poll_group::result result;
+        bool closed = false;
+        while ( pg.next_result(result) != -1 )
         {
-            std::cout << "[client] error happened (poll result has error)\n";
-            break;
-        }
+            if (result.error)
+            {
+                std::cout << "[client] error happened (poll result has error)\n";
+                closed = true;
+                break;
+            }
 
-        if (result.disconnected)
-        {
-            std::cout << "[client] server closed.\n";
-            break;
-        }
+            if (result.disconnected)
+            {
+                std::cout << "[client] server closed.\n";
+                closed = true;
+                break;
+            }
 
-        if (result.writable)
-        {
-            client.tick(false, true);
-            std::cout << "[client] client ticked\n";
+            if (result.writable)
+            {
+                client.tick(false, true);
+                std::cout << "[client] client ticked\n";
+            }
         }
+        if (closed) break;
     }
 }
 
@@ -124,6 +162,8 @@ int main()
     client();
 #elif defined(BUILD_SERVER)
     server();
+#elif defined(BUILD_SHARDED_SERVER)
+    sharded_server();
 #elif defined(BUILD_TESTS)
     tester::run_test(true);
 #elif defined(BUILD_HTTP_FILE_SERVER)